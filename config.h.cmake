@@ -71,6 +71,12 @@
 /* Define to 1 if your compiler supports variadic templates */
 #cmakedefine HAVE_VARIADIC_TEMPLATES 1
 
+/* Define to 1 if you have the `recvmmsg' function. */
+#cmakedefine HAVE_RECVMMSG 1
+
+/* Define to 1 if you have the `sendmmsg' function. */
+#cmakedefine HAVE_SENDMMSG 1
+
 /* Define to 1 if you have the `vasprintf' function. */
 #cmakedefine HAVE_VASPRINTF 1
 
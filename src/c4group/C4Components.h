@@ -111,6 +111,7 @@
 #define C4CFN_UpperBoard      "UpperBoard"
 #define C4CFN_Logo            "Logo"
 #define C4CFN_MoreMusic       "MoreMusic.txt"
+#define C4CFN_ScriptCache     "ScriptCache.bin"
 #define C4CFN_DynLandscape    "Landscape.txt"
 #define C4CFN_ClonkNames      "ClonkNames%s.txt|ClonkNames.txt"
 #define C4CFN_ClonkNameFiles  "ClonkNames*.txt"
@@ -141,6 +142,7 @@
 #define C4CFN_LogEx           "OpenClonk%d.log" // created if regular logfile is in use
 #define C4CFN_LogShader       "OpenClonkShaders.log" // created in editor mode to dump shader code
 #define C4CFN_Intro           "Clonk4.avi"
+#define C4CFN_NetResCache     "Cache" // subfolder of the network work path
 #define C4CFN_Names           "Names.txt"
 #define C4CFN_Titles          "Title*.txt|Title.txt"
 #define C4CFN_DefNameFiles    "Names*.txt|Names.txt"
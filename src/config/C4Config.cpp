@@ -86,6 +86,7 @@ void C4ConfigDeveloper::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(s(AltTodoFilename), "AltTodoFilename2",   "{USERPATH}/TODO.txt", false, true));
 	pComp->Value(mkNamingAdapt(MaxScriptMRU,        "MaxScriptMRU",       30                  , false, false));
 	pComp->Value(mkNamingAdapt(DebugShapeTextures,  "DebugShapeTextures", 0                   , false, true));
+	pComp->Value(mkNamingAdapt(ScriptCache,         "ScriptCache",        1                   , false, true));
 }
 
 void C4ConfigGraphics::CompileFunc(StdCompiler *pComp)
@@ -128,6 +129,7 @@ void C4ConfigSound::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(Verbose,               "Verbose",              0             ));
 	pComp->Value(mkNamingAdapt(MusicVolume,           "MusicVolume2",         40            ,false, true));
 	pComp->Value(mkNamingAdapt(SoundVolume,           "SoundVolume",          100           ,false, true));
+	pComp->Value(mkNamingAdapt(SampleCacheSize,       "SampleCacheSize",      64            ,false, true));
 }
 
 void C4ConfigNetwork::CompileFunc(StdCompiler *pComp)
@@ -147,6 +149,8 @@ void C4ConfigNetwork::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(ControlMode,             "ControlMode",          0             ));
 	pComp->Value(mkNamingAdapt(Nick,                    "Nick",                 ""            ,false, true));
 	pComp->Value(mkNamingAdapt(MaxLoadFileSize,         "MaxLoadFileSize",      5*1024*1024   ,false, true));
+	pComp->Value(mkNamingAdapt(ResCacheSize,            "ResCacheSize",         256           ,false, true));
+	pComp->Value(mkNamingAdapt(CompressControl,         "CompressControl",      1             ,false, true));
 
 	pComp->Value(mkNamingAdapt(MasterServerSignUp,      "MasterServerSignUp",   1             ));
 	pComp->Value(mkNamingAdapt(MasterServerActive,      "MasterServerActive",   0             ));
@@ -163,6 +167,8 @@ void C4ConfigNetwork::CompileFunc(StdCompiler *pComp)
 #endif
 	pComp->Value(mkNamingAdapt(AsyncMaxWait,            "AsyncMaxWait",         2             ));
 	pComp->Value(mkNamingAdapt(PacketLogging,           "PacketLogging",        0             ));
+	pComp->Value(mkNamingAdapt(s(MetricsFile),          "MetricsFile",          ""            ,false, true));
+	pComp->Value(mkNamingAdapt(MetricsInterval,         "MetricsInterval",      5             ,false, true));
 	
 
 	pComp->Value(mkNamingAdapt(mkParAdapt(LastLeagueServer, StdCompiler::RCT_All),     "LastLeagueServer",     ""            ));
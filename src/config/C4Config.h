@@ -87,6 +87,7 @@ public:
 	char AltTodoFilename[CFG_MaxString + 1];
 	int32_t MaxScriptMRU; // maximum number of remembered elements in recently used scripts
 	int32_t DebugShapeTextures; // if nonzero, show messages about loaded shape textures
+	int32_t ScriptCache; // if nonzero, keep the byte code of scripts in the user path between starts
 	void CompileFunc(StdCompiler *pComp);
 };
 
@@ -133,6 +134,7 @@ public:
 	int32_t Verbose;  // show music files names
 	int32_t MusicVolume;
 	int32_t SoundVolume;
+	int32_t SampleCacheSize; // in MB: decoded sound effects beyond this are freed when unused
 	void CompileFunc(StdCompiler *pComp);
 };
 
@@ -157,6 +159,8 @@ public:
 	int32_t ControlMode;
 	ValidatedStdCopyStrBuf<C4InVal::VAL_NameAllowEmpty> Nick;
 	int32_t MaxLoadFileSize;
+	int32_t ResCacheSize; // (MB) size limit of the downloaded resource cache; 0 to disable
+	int32_t CompressControl; // deflate control traffic on connections to clients that support it
 	char LastPassword[CFG_MaxString+1];
 	char AlternateServerAddress[CFG_MaxString+1];
 	StdCopyStrBuf LastLeagueServer, LastLeaguePlayerName, LastLeagueAccount, LastLeagueLoginToken;
@@ -167,6 +171,8 @@ public:
 #endif
 	int32_t AsyncMaxWait;
 	int32_t PacketLogging;
+	char MetricsFile[CFG_MaxString+1]; // if set, network metrics are written to this file periodically
+	int32_t MetricsInterval; // (s)
 public:
 	void CompileFunc(StdCompiler *pComp);
 	const char *GetLeagueServerAddress();
@@ -244,6 +244,7 @@ void C4Application::ParseCommandLine(int argc, char * argv[])
 			{"data", required_argument, 0, 'd'},
 			{"startup", required_argument, 0, 's'},
 			{"stream", required_argument, 0, 'e'},
+			{"metrics", required_argument, 0, 'M'},
 			{"recdump", required_argument, 0, 'R'},
 			{"comment", required_argument, 0, 'm'},
 			{"pass", required_argument, 0, 'p'},
@@ -338,6 +339,8 @@ void C4Application::ParseCommandLine(int argc, char * argv[])
 		case 'R': Game.RecordDumpFile.Copy(optarg); break;
 		// record stream
 		case 'e': Game.RecordStream.Copy(optarg); break;
+		// network metrics output
+		case 'M': SCopy(optarg, Config.Network.MetricsFile, CFG_MaxString); break;
 		// startup start screen
 		case 's': C4Startup::SetStartScreen(optarg); break;
 		// additional read-only data path
@@ -886,11 +889,13 @@ bool C4ApplicationGameTimer::Execute(int iTimeout, pollfd *)
 	// Check timer and reset
 	if (!CheckAndReset()) return true;
 	C4TimeMilliseconds tNow = C4TimeMilliseconds::Now();
+	// Network host slows down while control arrives late
+	uint32_t iPacingDelay = ::Control.isNetwork() ? ::Control.Network.GetPacingDelay() : 0;
 	// Execute
-	if (tNow >= tLastGameTick + iExtraGameTickDelay || Game.GameGo)
+	if (tNow >= tLastGameTick + iExtraGameTickDelay + iPacingDelay || Game.GameGo)
 	{
 		if (iGameTickDelay)
-			tLastGameTick += iGameTickDelay;
+			tLastGameTick += iGameTickDelay + iPacingDelay;
 		else
 			tLastGameTick = tNow;
 
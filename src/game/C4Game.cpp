@@ -575,6 +575,7 @@ void C4Game::Clear()
 	Landscape.Clear();
 	PXS.Clear();
 	if (pGlobalEffects) { delete pGlobalEffects; pGlobalEffects=NULL; }
+	GlobalEffectClock=C4EffectClock();
 	ScriptGuiRoot.reset();
 	Particles.Clear();
 	::MaterialMap.Clear();
@@ -594,6 +595,7 @@ void C4Game::Clear()
 	Application.SoundSystem.Modifiers.Clear(); // free some prop list pointers
 
 	PathFinder.Clear();
+	PathFinder.ClearCache();
 	TransferZones.Clear();
 #ifndef USE_CONSOLE
 	::FontLoader.Clear();
@@ -1280,15 +1282,12 @@ int32_t C4Game::ObjectCount(C4ID id)
 // Deletes removal-assigned data from list.
 // Pointer clearance is done by AssignRemoval.
 
-void C4Game::ObjectRemovalCheck() // Every ::Game.iTick255 by ExecObjects
+void C4Game::ObjectRemovalCheck(const std::vector<C4Object *> &Removals) // Every tick by ExecObjects
 {
-	for (C4Object *cObj : Objects)
+	for (C4Object *cObj : Removals)
 	{
-		if (!cObj->Status && (cObj->RemovalDelay==0))
-		{
-			Objects.Remove(cObj);
-			delete cObj;
-		}
+		Objects.Remove(cObj);
+		delete cObj;
 	}
 }
 
@@ -1298,6 +1297,7 @@ void C4Game::ExecObjects() // Every Tick1 by Execute
 		AddDbgRec(RCT_Block, "ObjEx", 6);
 
 	// Execute objects - reverse order to ensure
+	std::vector<C4Object *> Removals;
 	for (C4Object *cObj : Objects.reverse())
 	{
 		if (cObj)
@@ -1306,8 +1306,12 @@ void C4Game::ExecObjects() // Every Tick1 by Execute
 				// Execute object
 				cObj->Execute();
 			else
+			{
 				// Status reset: process removal delay
 				if (cObj->RemovalDelay>0) cObj->RemovalDelay--;
+				// removal delay done: delete every 255 ticks, spread by object number
+				else if (IsObjectTick(255, cObj->Number)) Removals.push_back(cObj);
+			}
 		}
 	}
 
@@ -1331,7 +1335,7 @@ void C4Game::ExecObjects() // Every Tick1 by Execute
 		AddDbgRec(RCT_Block, "ObjRm", 6);
 
 	// Removal
-	if (!::Game.iTick255) ObjectRemovalCheck();
+	if (!Removals.empty()) ObjectRemovalCheck(Removals);
 }
 
 C4ID DefFileGetID(const char *szFilename)
@@ -1464,6 +1468,7 @@ void C4Game::Default()
 	pScenarioSections=pCurrentScenarioSection=NULL;
 	*CurrentScenarioSection=0;
 	pGlobalEffects=NULL;
+	GlobalEffectClock=C4EffectClock();
 	fResortAnyObject=false;
 	pNetworkStatistics.reset();
 	::Application.MusicSystem.ClearGame();
@@ -2003,7 +2008,7 @@ bool C4Game::QuickSave(const char *strFilename, const char *strTitle, bool fForc
 bool LandscapeFree(int32_t x, int32_t y)
 {
 	if (!Inside<int32_t>(x,0,GBackWdt-1) || !Inside<int32_t>(y,0,GBackHgt-1)) return false;
-	return !DensitySolid(GBackDensity(x,y));
+	return !::Landscape._GetSolid(x,y);
 }
 
 static void FileMonitorCallback(const char * file, const char * extrafile)
@@ -2413,6 +2418,10 @@ bool C4Game::InitScriptEngine()
 
 bool C4Game::LinkScriptEngine()
 {
+	// reuse the code of unchanged functions from earlier starts
+	if (Config.Developer.ScriptCache)
+		ScriptEngine.CodeCache.Load(Config.AtUserDataPath(C4CFN_ScriptCache));
+
 	// Link script engine (resolve includes/appends, generate code)
 	ScriptEngine.Link(&::Definitions);
 
@@ -2422,6 +2431,13 @@ bool C4Game::LinkScriptEngine()
 		ScriptEngine.warnCnt, (ScriptEngine.warnCnt != 1 ? "s" : ""),
 		ScriptEngine.errCnt, (ScriptEngine.errCnt != 1 ? "s" : ""));
 
+	if (Config.Developer.ScriptCache)
+	{
+		LogSilentF("Script code cache: %d function%s reused, %d generated",
+			ScriptEngine.CodeCache.Hits, (ScriptEngine.CodeCache.Hits != 1 ? "s" : ""), ScriptEngine.CodeCache.Misses);
+		ScriptEngine.CodeCache.Save();
+	}
+
 	// Set name list for globals
 	ScriptEngine.GlobalNamed.SetNameList(&ScriptEngine.GlobalNamedNames);
 	
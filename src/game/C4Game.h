@@ -26,8 +26,10 @@
 #include "C4Scoreboard.h"
 #include <C4PlayerControl.h>
 #include <C4TransferZone.h>
+#include <C4Effect.h>
 
 #include <memory>
+#include <vector>
 
 class C4ScriptGuiWindow;
 
@@ -84,6 +86,7 @@ public:
 	class C4ScenarioObjectsScriptHost *pScenarioObjectsScript;
 	C4ScenarioSection   *pScenarioSections, *pCurrentScenarioSection;
 	C4Effect            *pGlobalEffects;
+	C4EffectClock       GlobalEffectClock;
 	C4PlayerControlDefs PlayerControlDefs;
 	C4PlayerControlAssignmentSets PlayerControlUserAssignmentSets, PlayerControlDefaultAssignmentSets;
 	C4Scoreboard        Scoreboard;
@@ -120,6 +123,8 @@ public:
 	bool fPreinited; // set after PreInit has been called; unset by Clear and Default
 	int32_t FrameCounter;
 	int32_t iTick2,iTick3,iTick5,iTick10,iTick35,iTick255,iTick1000;
+	// periodic per-object work: due every iPeriod frames, spread across frames by object number
+	bool IsObjectTick(int32_t iPeriod, int32_t iObjNumber) const { return !((FrameCounter + iObjNumber) % iPeriod); }
 	bool TimeGo;
 	int32_t Time;
 	int32_t StartTime;
@@ -266,7 +271,7 @@ protected:
 	                     C4Real xdir, C4Real ydir, C4Real rdir,
 						 int32_t con, int32_t iController, bool grow_from_center);
 	void ClearObjectPtrs(C4Object *tptr);
-	void ObjectRemovalCheck();
+	void ObjectRemovalCheck(const std::vector<C4Object *> &Removals);
 
 	bool ToggleDebugMode(); // dbg modeon/off if allowed
 	bool ActivateMenu(const char *szCommand); // exec given menu command for first local player
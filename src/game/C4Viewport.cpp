@@ -263,6 +263,9 @@ void C4Viewport::Draw(C4TargetFacet &cgo0, bool fDrawGame, bool fDrawOverlay)
 			::Landscape.Sky.Draw(cgo);
 		C4ST_STOP(SkyStat)
 
+			// animate all meshes in view at once
+			const FLOAT_RECT meshRect = { cgo.TargetX, cgo.TargetX + cgo.Wdt, cgo.TargetY, cgo.TargetY + cgo.Hgt };
+			::Objects.UpdateMeshPoses(C4Rect(meshRect), Player);
 			::Objects.Draw(cgo, Player, -2147483647 - 1 /* INT32_MIN */, 0);
 
 		// Draw Landscape
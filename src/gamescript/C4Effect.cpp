@@ -30,6 +30,8 @@
 #include <C4GameObjects.h>
 #include <C4SoundSystem.h>
 
+#include <limits>
+
 void C4Effect::AssignCallbackFunctions()
 {
 	C4PropList *p = GetCallbackScript();
@@ -62,7 +64,8 @@ C4Effect::C4Effect(C4Object *pForObj, C4String *szName, int32_t iPrio, int32_t i
 	// assign values
 	iPriority = 0; // effect is not yet valid; some callbacks to other effects are done before
 	iInterval = iTimerInterval;
-	iTime = 0;
+	pClock = NULL;
+	iTimeBase = iTimeSet = 0;
 	CommandTarget = pCmdTarget;
 	idCommandTarget = idCmdTarget;
 	AcquireNumber();
@@ -75,6 +78,8 @@ void C4Effect::Register(C4Object *pForObj, int32_t iPrio)
 {
 	// get effect target
 	C4Effect **ppEffectList = pForObj ? &pForObj->pEffects : &Game.pGlobalEffects;
+	SetClock(pForObj ? &pForObj->EffectClock : &Game.GlobalEffectClock);
+	pClock->Invalidate();
 	C4Effect *pCheck, *pPrev = *ppEffectList;
 	if (pPrev && Abs(pPrev->iPriority) < iPrio)
 	{
@@ -140,7 +145,9 @@ C4Effect * C4Effect::New(C4Object * pForObj, C4String * szName, int32_t iPrio, i
 C4Effect::C4Effect()
 {
 	// defaults
-	iPriority=iTime=iInterval=0;
+	iPriority=iInterval=0;
+	pClock=NULL;
+	iTimeBase=iTimeSet=0;
 	CommandTarget=NULL;
 	pNext = NULL;
 }
@@ -273,10 +280,46 @@ C4Effect* C4Effect::Check(C4Object *pForObj, const char *szCheckEffect, int32_t
 	return 0;
 }
 
+void C4Effect::SetTime(int32_t iToTime)
+{
+	int32_t iClockTime = pClock ? pClock->Time : 0;
+	iTimeBase = iClockTime - iToTime;
+	iTimeSet = iClockTime;
+	if (pClock) pClock->Invalidate();
+}
+
+void C4Effect::SetInterval(int32_t iToInterval)
+{
+	iInterval = iToInterval;
+	if (pClock) pClock->Invalidate();
+}
+
+void C4Effect::SetClock(C4EffectClock *pToClock)
+{
+	int32_t iCurrTime = GetTime();
+	pClock = pToClock;
+	SetTime(iCurrTime);
+}
+
+int32_t C4Effect::GetNextTimer() const
+{
+	// next time at which effect time is a multiple of the interval
+	int32_t iAbsInterval = Abs(iInterval);
+	int32_t iRemain = GetTime() % iAbsInterval;
+	if (iRemain < 0) iRemain += iAbsInterval;
+	int64_t iNext = int64_t(pClock->Time) + iAbsInterval - iRemain;
+	return int32_t(std::min<int64_t>(iNext, std::numeric_limits<int32_t>::max()));
+}
+
 void C4Effect::Execute(C4Object *pObj)
 {
 	// get effect list
 	C4Effect **ppEffectList = pObj ? &pObj->pEffects : &Game.pGlobalEffects;
+	C4EffectClock *pListClock = pObj ? &pObj->EffectClock : &Game.GlobalEffectClock;
+	// time elapsed for all effects; nothing else to do until a timer is due
+	if (++pListClock->Time < pListClock->NextDue) return;
+	pListClock->NextDue = std::numeric_limits<int32_t>::max();
+	int32_t iNextDue = std::numeric_limits<int32_t>::max();
 	// execute all effects not marked as dead
 	C4Effect *pEffect = this, **ppPrevEffect=ppEffectList;
 	do
@@ -293,14 +336,22 @@ void C4Effect::Execute(C4Object *pObj)
 		}
 		else
 		{
+			// loaded effects are not bound to the list clock yet
+			if (pEffect->pClock != pListClock) pEffect->SetClock(pListClock);
 			// execute effect: time elapsed
-			++pEffect->iTime;
+			// this has been done by the clock, unless the time was set during this execution
+			if (pEffect->iTimeSet == pListClock->Time)
+			{
+				--pEffect->iTimeBase;
+				--pEffect->iTimeSet;
+			}
+			int32_t iTime = pEffect->GetTime();
 			// check timer execution
-			if (pEffect->iInterval && !(pEffect->iTime % pEffect->iInterval))
+			if (pEffect->iInterval && !(iTime % pEffect->iInterval))
 			{
 				if (pEffect->pFnTimer)
 				{
-					if (pEffect->pFnTimer->Exec(pEffect->CommandTarget, &C4AulParSet(C4VObj(pObj), C4VPropList(pEffect), C4VInt(pEffect->iTime))).getInt() == C4Fx_Execute_Kill)
+					if (pEffect->pFnTimer->Exec(pEffect->CommandTarget, &C4AulParSet(C4VObj(pObj), C4VPropList(pEffect), C4VInt(iTime))).getInt() == C4Fx_Execute_Kill)
 					{
 						// safety: this class got deleted!
 						if (pObj && !pObj->Status) return;
@@ -314,12 +365,17 @@ void C4Effect::Execute(C4Object *pObj)
 					// no timer function: mark dead after time elapsed
 					pEffect->Kill(pObj);
 			}
+			// remember when this effect needs to be executed next
+			if (!pEffect->IsDead() && pEffect->iInterval)
+				iNextDue = std::min(iNextDue, pEffect->GetNextTimer());
 			// next effect
 			ppPrevEffect = &pEffect->pNext;
 			pEffect = pEffect->pNext;
 		}
 	}
 	while (pEffect);
+	// skip executions until then, unless the effects were changed meanwhile
+	if (pListClock->NextDue) pListClock->NextDue = iNextDue;
 }
 
 void C4Effect::Kill(C4Object *pObj)
@@ -460,7 +516,9 @@ void C4Effect::CompileFunc(StdCompiler *pComp, C4ValueNumbers * numbers)
 	// read priority
 	pComp->Value(iPriority); pComp->Separator();
 	// read time and intervall
+	int32_t iTime = GetTime();
 	pComp->Value(iTime); pComp->Separator();
+	if (pComp->isCompiler()) SetTime(iTime);
 	pComp->Value(iInterval); pComp->Separator();
 	// read object number
 	pComp->Value(CommandTarget); pComp->Separator();
@@ -498,10 +556,10 @@ void C4Effect::SetPropertyByS(C4String * k, const C4Value & to)
 				return;
 			case P_Priority:
 				throw C4AulExecError("effect: Priority is readonly");
-			case P_Interval: iInterval = to.getInt(); return;
+			case P_Interval: SetInterval(to.getInt()); return;
 			case P_CommandTarget:
 				throw C4AulExecError("effect: CommandTarget is readonly");
-			case P_Time: iTime = to.getInt(); return;
+			case P_Time: SetTime(to.getInt()); return;
 			case P_Prototype:
 				throw new C4AulExecError("effect: Prototype is readonly");
 		}
@@ -519,10 +577,10 @@ void C4Effect::ResetProperty(C4String * k)
 				throw C4AulExecError("effect: Name has to be a nonempty string");
 			case P_Priority:
 				throw C4AulExecError("effect: Priority is readonly");
-			case P_Interval: iInterval = 0; return;
+			case P_Interval: SetInterval(0); return;
 			case P_CommandTarget:
 				throw C4AulExecError("effect: CommandTarget is readonly");
-			case P_Time: iTime = 0; return;
+			case P_Time: SetTime(0); return;
 			case P_Prototype:
 				throw new C4AulExecError("effect: Prototype is readonly");
 		}
@@ -549,7 +607,7 @@ bool C4Effect::GetPropertyByS(C4String *k, C4Value *pResult) const
 				//*pResult = CommandTarget ? C4VObj(CommandTarget) :
 				//           (idCommandTarget ? C4VPropList(Definitions.ID2Def(idCommandTarget)) : C4VNull);
 				return true;
-			case P_Time: *pResult = C4VInt(iTime); return true;
+			case P_Time: *pResult = C4VInt(GetTime()); return true;
 		}
 	}
 	return C4PropListNumbered::GetPropertyByS(k, pResult);
@@ -66,6 +66,17 @@
 #define C4Fx_FireParticle1   "Fire"
 #define C4Fx_FireParticle2   "Fire2"
 
+// execution clock of an effect list (per object and for global effects)
+// effect times are derived from it, so the list needs to be walked only when a timer is due
+struct C4EffectClock
+{
+	int32_t Time;    // number of executions of the effect list
+	int32_t NextDue; // clock time at which the next timer is due; 0 forces a walk on next execution
+
+	C4EffectClock(): Time(0), NextDue(0) { }
+	void Invalidate() { NextDue = 0; } // effects changed: walk list on next execution
+};
+
 // generic object effect
 class C4Effect: public C4PropListNumbered
 {
@@ -74,11 +85,15 @@ public:
 	C4ID idCommandTarget;     // ID of command target definition
 
 	int32_t iPriority;          // effect priority for sorting into effect list; -1 indicates a dead effect
-	int32_t iTime, iInterval;  // effect time; effect callback intervall
+	int32_t iInterval;          // effect callback intervall
 
 	C4Effect *pNext;        // next effect in linked list
 
 protected:
+	C4EffectClock *pClock;  // clock of the effect list this effect is in
+	int32_t iTimeBase;      // effect time is clock time minus this
+	int32_t iTimeSet;       // clock time at which effect time was last set
+
 	// presearched callback functions for faster calling
 	C4AulFunc *pFnTimer;           // timer function Fx%sTimer
 	C4AulFunc *pFnStart, *pFnStop; // init/deinit-functions Fx%sStart, Fx%sStop
@@ -99,12 +114,16 @@ public:
 	void Denumerate(C4ValueNumbers *); // numbers to object pointers
 	void ClearPointers(C4Object *pObj); // clear all pointers to object - may kill some effects w/o callback, because the callback target is lost
 
-	void SetDead() { iPriority=0; }      // mark effect to be removed in next execution cycle
+	void SetDead() { iPriority=0; if (pClock) pClock->Invalidate(); } // mark effect to be removed in next execution cycle
 	bool IsDead() { return !iPriority; } // return whether effect is to be removed
 	void FlipActive() { iPriority*=-1; } // alters activation status
 	bool IsActive() { return iPriority>0; } // returns whether effect is active
 	bool IsInactiveAndNotDead() { return iPriority<0; } // as the name says
 
+	int32_t GetTime() const { return (pClock ? pClock->Time : 0) - iTimeBase; } // effect time
+	void SetTime(int32_t iToTime);   // set effect time
+	void SetInterval(int32_t iToInterval); // set timer interval
+
 	C4Effect *Get(const char *szName, int32_t iIndex=0, int32_t iMaxPriority=0);  // get effect by name
 	int32_t GetCount(const char *szMask, int32_t iMaxPriority=0); // count effects that match the mask
 	C4Effect *Check(C4Object *pForObj, const char *szCheckEffect, int32_t iPrio, int32_t iTimer, const C4Value &rVal1, const C4Value &rVal2, const C4Value &rVal3, const C4Value &rVal4); // do some effect callbacks
@@ -134,6 +153,8 @@ public:
 	virtual C4ValueArray * GetProperties() const;
 
 protected:
+	void SetClock(C4EffectClock *pToClock); // move to another list clock, keeping the effect time
+	int32_t GetNextTimer() const;           // clock time of the next timer call
 	void TempRemoveUpperEffects(C4Object *pObj, bool fTempRemoveThis, C4Effect **ppLastRemovedEffect); // temp remove all effects with higher priority
 	void TempReaddUpperEffects(C4Object *pObj, C4Effect *pLastReaddEffect); // temp remove all effects with higher priority
 };
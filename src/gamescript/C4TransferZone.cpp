@@ -49,6 +49,7 @@ C4TransferZones::~C4TransferZones()
 void C4TransferZones::Default()
 {
 	First=NULL;
+	ChangeCount=0;
 }
 
 void C4TransferZones::Clear()
@@ -56,6 +57,7 @@ void C4TransferZones::Clear()
 	C4TransferZone *pZone,*pNext;
 	for (pZone=First; pZone; pZone=pNext) { pNext=pZone->Next; delete pZone; }
 	First=NULL;
+	ChangeCount++;
 }
 
 void C4TransferZones::ClearPointers(C4Object *pObj)
@@ -76,8 +78,10 @@ bool C4TransferZones::Set(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4
 	// Update existing zone
 	if ((pZone=Find(pObj)))
 	{
+		if (pZone->X==iX && pZone->Y==iY && pZone->Wdt==iWdt && pZone->Hgt==iHgt) return true;
 		pZone->X=iX; pZone->Y=iY;
 		pZone->Wdt=iWdt; pZone->Hgt=iHgt;
+		ChangeCount++;
 	}
 	// Allocate and add new zone
 	else
@@ -96,6 +100,7 @@ bool C4TransferZones::Add(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4
 	pZone->Object=pObj;
 	pZone->Next=First;
 	First=pZone;
+	ChangeCount++;
 	// Success
 	return true;
 }
@@ -152,6 +157,7 @@ int32_t C4TransferZones::RemoveNullZones()
 		else
 			pPrev=pZone;
 	}
+	if (iResult) ChangeCount++;
 	return iResult;
 }
 
@@ -46,6 +46,7 @@ public:
 protected:
 	int32_t RemoveNullZones();
 	C4TransferZone *First;
+	int32_t ChangeCount; // increased whenever the zone set changes
 public:
 	void Default();
 	void Clear();
@@ -57,6 +58,7 @@ public:
 	C4TransferZone* Find(int32_t iX, int32_t iY);
 	bool Add(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4Object *pObj);
 	bool Set(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4Object *pObj);
+	int32_t GetChangeCount() const { return ChangeCount; }
 };
 
 #endif
@@ -452,6 +452,8 @@ bool C4Draw::RenderMesh(StdMeshInstance &instance, C4Surface * sfcTarget, float
 	if (!PrepareRendering(sfcTarget)) return false;
 	// Update bone matrices and vertex data (note this also updates attach transforms and child transforms)
 	instance.UpdateBoneTransforms();
+	// Catch up on texture animation (also for attached meshes)
+	instance.UpdateTextureAnimation();
 	// Order faces according to MeshTransformation (note pTransform does not affect Z coordinate, so does not need to be taken into account for correct ordering)
 	StdMeshMatrix mat = StdMeshMatrix::Identity();
 	if(MeshTransform) mat = *MeshTransform * mat;
@@ -28,6 +28,7 @@
 
 #include <C4Include.h>
 #include <C4ScriptGuiWindow.h>
+#include <limits>
 
 #include <C4Application.h>
 #include <C4DefList.h>
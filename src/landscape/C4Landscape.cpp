@@ -107,6 +107,74 @@ namespace
 		}
 		return true;
 	}
+
+	// bit helpers for scanning the solidity bitmap
+	inline int32_t CountBits(uint32_t v)
+	{
+#ifdef __GNUC__
+		return __builtin_popcount(v);
+#else
+		v = v - ((v >> 1) & 0x55555555u);
+		v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+		return (((v + (v >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+#endif
+	}
+
+	inline int32_t LowestBit(uint32_t v) // v must not be zero
+	{
+#ifdef __GNUC__
+		return __builtin_ctz(v);
+#else
+		int32_t i = 0; while (!(v & 1u)) { v >>= 1; ++i; }
+		return i;
+#endif
+	}
+
+	inline int32_t HighestBit(uint32_t v) // v must not be zero
+	{
+#ifdef __GNUC__
+		return 31 - __builtin_clz(v);
+#else
+		int32_t i = 31; while (!(v & 0x80000000u)) { v <<= 1; --i; }
+		return i;
+#endif
+	}
+}
+
+void C4LandscapeTiles::Clear()
+{
+	TilesX = 0;
+	Uniform.clear();
+	Tiles.clear();
+}
+
+void C4LandscapeTiles::Init(const CSurface8 &rSfc)
+{
+	Clear();
+	TilesX = (rSfc.Wdt + C4LS_TileSize - 1) >> C4LS_TileShift;
+	int32_t iTilesY = (rSfc.Hgt + C4LS_TileSize - 1) >> C4LS_TileShift;
+	Uniform.resize(TilesX * iTilesY);
+	Tiles.resize(TilesX * iTilesY);
+	for (int32_t ty = 0; ty < iTilesY; ty++)
+		for (int32_t tx = 0; tx < TilesX; tx++)
+		{
+			int32_t x0 = tx << C4LS_TileShift, y0 = ty << C4LS_TileShift;
+			int32_t x1 = std::min<int32_t>(x0 + C4LS_TileSize, rSfc.Wdt), y1 = std::min<int32_t>(y0 + C4LS_TileSize, rSfc.Hgt);
+			// single color?
+			BYTE byFirst = rSfc._GetPix(x0, y0);
+			bool fUniform = true;
+			for (int32_t y = y0; y < y1 && fUniform; y++)
+				for (int32_t x = x0; x < x1; x++)
+					if (rSfc._GetPix(x, y) != byFirst) { fUniform = false; break; }
+			Uniform[ty * TilesX + tx] = byFirst;
+			if (fUniform) continue;
+			// store tile pixels (parts outside the surface stay unused)
+			BYTE *pData = new BYTE[C4LS_TileSize * C4LS_TileSize];
+			for (int32_t y = y0; y < y1; y++)
+				for (int32_t x = x0; x < x1; x++)
+					pData[((y - y0) << C4LS_TileShift) + (x - x0)] = rSfc._GetPix(x, y);
+			Tiles[ty * TilesX + tx].reset(pData);
+		}
 }
 
 C4Landscape::C4Landscape()
@@ -147,17 +215,18 @@ void C4Landscape::ExecuteScan()
 
 	// Check: Scan needed?
 	const int32_t iTemperature = ::Weather.GetTemperature();
+	int32_t ReactingMats[C4MaxMaterial], iReactingCnt = 0;
 	for (mat = 0; mat < ::MaterialMap.Num; mat++)
 		if (MatCount[mat])
 		{
 			if (::MaterialMap.Map[mat].BelowTempConvertTo &&
 			    iTemperature < ::MaterialMap.Map[mat].BelowTempConvert)
-				break;
+				ReactingMats[iReactingCnt++] = mat;
 			else if (::MaterialMap.Map[mat].AboveTempConvertTo &&
 			         iTemperature > ::MaterialMap.Map[mat].AboveTempConvert)
-				break;
+				ReactingMats[iReactingCnt++] = mat;
 		}
-	if (mat >= ::MaterialMap.Num)
+	if (!iReactingCnt)
 		return;
 
 #ifdef DEBUGREC_MATSCAN
@@ -169,9 +238,10 @@ void C4Landscape::ExecuteScan()
 	{
 
 		// Scan landscape column: sectors down
-		int32_t last_mat = -1;
+		int32_t last_mat = -1, next_tile_y = 0;
 		for (cy=0; cy<Height; cy++)
 		{
+			int32_t row = cy;
 			mat=_GetMat(ScanX, cy);
 			// material change?
 			if (last_mat != mat)
@@ -184,6 +254,17 @@ void C4Landscape::ExecuteScan()
 					cy += DoScan(ScanX, cy, mat, 0);
 			}
 			last_mat = mat;
+			// entering a tile without reacting material: material changes within it do nothing, so go to its last row
+			if (cy == row && cy >= next_tile_y)
+			{
+				next_tile_y = ((cy >> C4LS_TileShift) + 1) << C4LS_TileShift;
+				int32_t last_row = std::min(next_tile_y, Height) - 1;
+				if (cy < last_row - 1 && !MatTileHasAny(ScanX, cy, ReactingMats, iReactingCnt))
+				{
+					cy = last_row - 1;
+					last_mat = _GetMat(ScanX, cy);
+				}
+			}
 		}
 
 		// Scan advance & rewind
@@ -744,6 +825,9 @@ bool C4Landscape::_SetPix2(int32_t x, int32_t y, BYTE fgPix, BYTE bgPix)
 	int32_t omat = Pix2Mat[opix], nmat = Pix2Mat[fgPix];
 	if (opix) MatCount[omat]--;
 	if (fgPix) MatCount[nmat]++;
+	uint16_t *pTileCount = &MatTileCount[((y >> C4LS_TileShift) * MatTilesX + (x >> C4LS_TileShift)) * C4MaxMaterial];
+	if (MatValid(omat)) pTileCount[omat]--;
+	if (MatValid(nmat)) pTileCount[nmat]++;
 	// count effective material
 	if (omat != nmat)
 	{
@@ -785,32 +869,61 @@ bool C4Landscape::_SetPix2(int32_t x, int32_t y, BYTE fgPix, BYTE bgPix)
 	// set 8bpp-surface only!
 	Surface8->SetPix(x, y, fgPix);
 	Surface8Bkg->SetPix(x, y, bgPix);
-	// note for relight
-	if(pLandscapeRender)
+	// paths through here might be different now
+	if (DensitySolid(Pix2Dens[fgPix]) != DensitySolid(Pix2Dens[opix]))
 	{
-		C4Rect CheckRect = pLandscapeRender->GetAffectedRect(C4Rect(x, y, 1, 1));
-		for (int32_t i = 0; i < C4LS_MaxRelights; i++)
-			if (!Relights[i].Wdt || Relights[i].Overlap(CheckRect) || i + 1 >= C4LS_MaxRelights)
-			{
-				Relights[i].Add(CheckRect);
-				break;
-			}
-		// Invalidate FoW
-		if (pFoW)
-			pFoW->Invalidate(CheckRect);
+		_SetSolidBit(x, y, DensitySolid(Pix2Dens[fgPix]));
+		Game.PathFinder.OnLandscapeChange(C4Rect(x, y, 1, 1));
 	}
+	// note for relight
+	AddRelight(C4Rect(x, y, 1, 1));
 	// success
 	return true;
 }
 
+void C4Landscape::AddRelight(const C4Rect &Rect)
+{
+	if (!pLandscapeRender) return;
+	C4Rect CheckRect = pLandscapeRender->GetAffectedRect(Rect);
+	for (int32_t i = 0; i < C4LS_MaxRelights; i++)
+		if (!Relights[i].Wdt || Relights[i].Overlap(CheckRect) || i + 1 >= C4LS_MaxRelights)
+		{
+			Relights[i].Add(CheckRect);
+			break;
+		}
+	// Invalidate FoW
+	if (pFoW)
+		pFoW->Invalidate(CheckRect);
+}
+
 void C4Landscape::_SetPix2Tmp(int32_t x, int32_t y, BYTE fgPix, BYTE bgPix)
 {
 	// set 8bpp-surface only!
 	assert(x >= 0 && y >= 0 && x < Width && y < Height);
-	if (fgPix != Transparent) Surface8->SetPix(x, y, fgPix);
+	if (fgPix != Transparent) { Surface8->SetPix(x, y, fgPix); _SetSolidBit(x, y, DensitySolid(Pix2Dens[fgPix])); }
 	if (bgPix != Transparent) Surface8Bkg->SetPix(x, y, bgPix);
 }
 
+void C4Landscape::PrepareSolidMaskChange(C4Rect BoundingBox)
+{
+	// Intersect bounding box with landscape
+	BoundingBox.Intersect(C4Rect(0, 0, Width, Height));
+	if (BoundingBox.Wdt <= 0 || BoundingBox.Hgt <= 0) return;
+	UpdateMatCnt(BoundingBox, false);
+}
+
+void C4Landscape::FinishSolidMaskChange(C4Rect BoundingBox)
+{
+	// Intersect bounding box with landscape
+	BoundingBox.Intersect(C4Rect(0, 0, Width, Height));
+	if (BoundingBox.Wdt <= 0 || BoundingBox.Hgt <= 0) return;
+	UpdateMatCnt(BoundingBox, true);
+	UpdatePixCnt(BoundingBox);
+	// one relight for the whole mask instead of one per pixel
+	AddRelight(BoundingBox);
+	Game.PathFinder.OnLandscapeChange(BoundingBox);
+}
+
 bool C4Landscape::CheckInstability(int32_t tx, int32_t ty, int32_t recursion_count)
 {
 	int32_t mat=GetMat(tx,ty);
@@ -1281,8 +1394,8 @@ void C4Landscape::Clear(bool fClearMapCreator, bool fClearSky, bool fClearRender
 	delete Map; Map=NULL;
 	delete MapBkg; MapBkg=NULL;
 	// clear initial landscape
-	delete [] pInitial; pInitial = NULL;
-	delete [] pInitialBkg; pInitialBkg = NULL;
+	Initial.Clear();
+	InitialBkg.Clear();
 	delete pFoW; pFoW = NULL;
 	// clear relight array
 	for (int32_t i = 0; i < C4LS_MaxRelights; ++i)
@@ -1293,6 +1406,10 @@ void C4Landscape::Clear(bool fClearMapCreator, bool fClearSky, bool fClearRender
 	// clear pixel count
 	delete [] PixCnt; PixCnt = NULL;
 	PixCntPitch = 0;
+	delete [] SolidBits; SolidBits = NULL;
+	SolidBitsPitch = 0;
+	MatTileCount.clear();
+	MatTilesX = 0;
 	// clear bridge material conversion temp buffers
 	for (int32_t i = 0; i < C4M_MaxTexIndex; ++i)
 	{
@@ -1488,6 +1605,11 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 	int32_t PixCntWidth = (Width + 16) / 17;
 	PixCntPitch = (Height + 14) / 15;
 	PixCnt = new uint8_t[PixCntWidth * PixCntPitch];
+	SolidBitsPitch = (Width + 31) / 32;
+	SolidBits = new uint32_t[SolidBitsPitch * Height];
+	std::fill_n(SolidBits, SolidBitsPitch * Height, 0u);
+	MatTilesX = (Width + C4LS_TileSize - 1) >> C4LS_TileShift;
+	MatTileCount.assign(MatTilesX * ((Height + C4LS_TileSize - 1) >> C4LS_TileShift) * C4MaxMaterial, 0);
 
 	// map to big surface and sectionize it
 	// (not for shaders though - they require continous textures)
@@ -1574,8 +1696,10 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 
 	// Pixel count tracking from landscape zoom is incomplete, so recalculate it.
 	UpdatePixCnt(C4Rect(0, 0, Width, Height));
+	UpdateSolidBits(C4Rect(0, 0, Width, Height));
 	ClearMatCount();
 	UpdateMatCnt(C4Rect(0, 0, Width, Height), true);
+	Game.PathFinder.ClearCache();
 
 	// Create initial landscape render data (after applying diff so landscape is complete)
 	if (pLandscapeRender) pLandscapeRender->Update(C4Rect(0, 0, Width, Height), this);
@@ -1645,8 +1769,8 @@ bool C4Landscape::SaveDiff(C4Group &hGroup, bool fSyncSave) const
 
 bool C4Landscape::SaveDiffInternal(C4Group &hGroup, bool fSyncSave) const
 {
-	assert(pInitial && pInitialBkg);
-	if (!pInitial || !pInitialBkg) return false;
+	assert(Initial.IsInitialized() && InitialBkg.IsInitialized());
+	if (!Initial.IsInitialized() || !InitialBkg.IsInitialized()) return false;
 
 	// If it shouldn't be sync-save: Clear all bytes that have not changed, i.e.
 	// set them to C4M_MaxTexIndex
@@ -1655,12 +1779,12 @@ bool C4Landscape::SaveDiffInternal(C4Group &hGroup, bool fSyncSave) const
 		for (int y = 0; y < Height; y++)
 			for (int x = 0; x < Width; x++)
 			{
-				if (pInitial[y * Width + x] == Surface8->_GetPix(x, y))
+				if (Initial.GetPix(x, y) == Surface8->_GetPix(x, y))
 					Surface8->SetPix(x,y,C4M_MaxTexIndex);
 				else
 					fChanged = true;
 
-				if (pInitialBkg[y * Width + x] == Surface8Bkg->_GetPix(x, y))
+				if (InitialBkg.GetPix(x, y) == Surface8Bkg->_GetPix(x, y))
 					Surface8Bkg->SetPix(x,y,C4M_MaxTexIndex);
 				else
 					fChangedBkg = true;
@@ -1696,9 +1820,9 @@ bool C4Landscape::SaveDiffInternal(C4Group &hGroup, bool fSyncSave) const
 			for (int x = 0; x < Width; x++)
 			{
 				if (Surface8->_GetPix(x, y) == C4M_MaxTexIndex)
-					Surface8->SetPix(x,y,pInitial[y * Width + x]);
+					Surface8->SetPix(x,y,Initial.GetPix(x, y));
 				if (Surface8Bkg->_GetPix(x, y) == C4M_MaxTexIndex)
-					Surface8Bkg->SetPix(x,y,pInitialBkg[y * Width + x]);
+					Surface8Bkg->SetPix(x,y,InitialBkg.GetPix(x, y));
 			}
 
 	// Save changed map, too
@@ -1714,19 +1838,9 @@ bool C4Landscape::SaveDiffInternal(C4Group &hGroup, bool fSyncSave) const
 bool C4Landscape::SaveInitial()
 {
 
-	// Create array
-	delete [] pInitial;
-	delete [] pInitialBkg;
-	pInitial = new BYTE [Width * Height];
-	pInitialBkg = new BYTE [Width * Height];
-
 	// Save material data
-	for (int y = 0; y < Height; y++)
-		for (int x = 0; x < Width; x++)
-		{
-			pInitial[y * Width + x] = Surface8->_GetPix(x, y);
-			pInitialBkg[y * Width + x] = Surface8Bkg->_GetPix(x, y);
-		}
+	Initial.Init(*Surface8);
+	InitialBkg.Init(*Surface8Bkg);
 
 	return true;
 }
@@ -1833,10 +1947,11 @@ void C4Landscape::Default()
 	Mode=C4LSC_Undefined;
 	Surface8=NULL;
 	Surface8Bkg=NULL;
-	pInitial=NULL;
-	pInitialBkg=NULL;
 	TopRowPix=NULL;
 	BottomRowPix=NULL;
+	SolidBits=NULL;
+	SolidBitsPitch=0;
+	MatTilesX=0;
 	pLandscapeRender=NULL;
 	Map=NULL;
 	MapBkg=NULL;
@@ -1863,6 +1978,7 @@ void C4Landscape::ClearMatCount()
 		MatCount[cnt]=0;
 		EffectiveMatCount[cnt]=0;
 	}
+	std::fill(MatTileCount.begin(), MatTileCount.end(), 0);
 }
 
 void C4Landscape::Synchronize()
@@ -2384,6 +2500,34 @@ bool C4Landscape::_PathFree(int32_t x, int32_t y, int32_t x2, int32_t y2) const
 	return !PixCnt[x * PixCntPitch + y];
 }
 
+bool C4Landscape::_FindSolidInRow(int32_t y, int32_t x, int32_t x2, int32_t *ix) const
+{
+	const uint32_t *pRow = SolidBits + y * SolidBitsPitch;
+	if (x <= x2)
+	{
+		// scan rightwards: lowest set bit at or after x
+		int32_t iWord = x >> 5, iLastWord = x2 >> 5;
+		uint32_t dwBits = pRow[iWord] & (~0u << (x & 31));
+		while (!dwBits && iWord < iLastWord) dwBits = pRow[++iWord];
+		if (!dwBits) return false;
+		int32_t iFound = (iWord << 5) + LowestBit(dwBits);
+		if (iFound > x2) return false;
+		if (ix) *ix = iFound;
+	}
+	else
+	{
+		// scan leftwards: highest set bit at or before x
+		int32_t iWord = x >> 5, iLastWord = x2 >> 5;
+		uint32_t dwBits = pRow[iWord] & (~0u >> (31 - (x & 31)));
+		while (!dwBits && iWord > iLastWord) dwBits = pRow[--iWord];
+		if (!dwBits) return false;
+		int32_t iFound = (iWord << 5) + HighestBit(dwBits);
+		if (iFound < x2) return false;
+		if (ix) *ix = iFound;
+	}
+	return true;
+}
+
 int32_t C4Landscape::GetMatHeight(int32_t x, int32_t y, int32_t iYDir, int32_t iMat, int32_t iMax) const
 {
 	if (iYDir > 0)
@@ -2782,11 +2926,23 @@ bool PathFreePix(int32_t x, int32_t y)
 
 bool PathFree(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
 {
+	// horizontal paths inside the landscape are checked word by word
+	if (y1 == y2 && Inside<int32_t>(y1, 0, GBackHgt-1) && Inside<int32_t>(x1, 0, GBackWdt-1) && Inside<int32_t>(x2, 0, GBackWdt-1))
+		return !::Landscape._FindSolidInRow(y1, x1, x2, NULL);
 	return ForLine(x1,y1,x2,y2,&PathFreePix);
 }
 
 bool PathFree(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t *ix, int32_t *iy)
 {
+	// horizontal paths inside the landscape are checked word by word
+	if (y1 == y2 && Inside<int32_t>(y1, 0, GBackHgt-1) && Inside<int32_t>(x1, 0, GBackWdt-1) && Inside<int32_t>(x2, 0, GBackWdt-1))
+	{
+		int32_t iHitX;
+		if (!::Landscape._FindSolidInRow(y1, x1, x2, &iHitX)) return true;
+		if (ix) {*ix = iHitX; *iy = y1;}
+		return false;
+	}
+
 	// use the standard Bresenham algorithm and just adjust it to behave correctly in the inversed case
 	bool reverse = false;
 	bool steep = Abs(y2 - y1) > Abs(x2 - x1);
@@ -3198,10 +3354,49 @@ bool C4Landscape::FindMatPathPush(int32_t &fx, int32_t &fy, int32_t mdens, int32
 int32_t C4Landscape::AreaSolidCount(int32_t x, int32_t y, int32_t wdt, int32_t hgt) const
 {
 	int32_t cx,cy,ascnt=0;
+	// part inside the landscape is counted word by word
+	int32_t ix1 = Clamp<int32_t>(x, 0, Width), ix2 = Clamp<int32_t>(x+wdt, ix1, Width);
 	for (cy=y; cy<y+hgt; cy++)
-		for (cx=x; cx<x+wdt; cx++)
+	{
+		if (!Inside<int32_t>(cy, 0, Height-1))
+		{
+			for (cx=x; cx<x+wdt; cx++)
+				if (GBackSolid(cx,cy))
+					ascnt++;
+			continue;
+		}
+		// rects entirely left or right of the landscape must not scan past their own edge
+		for (cx=x; cx<std::min(ix1, x+wdt); cx++)
+			if (GBackSolid(cx,cy))
+				ascnt++;
+		if (ix1 < ix2)
+		{
+			const uint32_t *pRow = SolidBits + cy * SolidBitsPitch;
+			int32_t iWord = ix1 >> 5, iLastWord = (ix2 - 1) >> 5;
+			uint32_t dwFirstMask = ~0u << (ix1 & 31), dwLastMask = ~0u >> (31 - ((ix2 - 1) & 31));
+			if (iWord == iLastWord)
+				ascnt += CountBits(pRow[iWord] & dwFirstMask & dwLastMask);
+			else
+			{
+				ascnt += CountBits(pRow[iWord] & dwFirstMask);
+				for (++iWord; iWord < iLastWord; ++iWord)
+					ascnt += CountBits(pRow[iWord]);
+				ascnt += CountBits(pRow[iLastWord] & dwLastMask);
+			}
+		}
+		for (cx=std::max(ix2, x); cx<x+wdt; cx++)
 			if (GBackSolid(cx,cy))
 				ascnt++;
+	}
+#ifdef _DEBUG
+	// cross-check against the plain per-pixel count
+	int32_t iCheck = 0;
+	for (cy=y; cy<y+hgt; cy++)
+		for (cx=x; cx<x+wdt; cx++)
+			if (GBackSolid(cx,cy))
+				iCheck++;
+	assert(ascnt == iCheck);
+#endif
 	return ascnt;
 }
 
@@ -3582,6 +3777,8 @@ void C4Landscape::FinishChange(C4Rect BoundingBox)
 	}
 	C4SolidMask::CheckConsistency();
 	UpdatePixCnt(BoundingBox);
+	UpdateSolidBits(BoundingBox);
+	Game.PathFinder.OnLandscapeChange(SolidMaskRect);
 	// update FoW
 	if (pFoW)
 	{
@@ -3810,6 +4007,8 @@ void C4Landscape::HandleTexMapUpdate()
 {
 	// Pixel maps must be update
 	UpdatePixMaps();
+	// densities of texture entries may have changed
+	if (SolidBits) UpdateSolidBits(C4Rect(0, 0, Width, Height));
 	// Update landscape palette
 	Mat2Pal();
 }
@@ -3867,12 +4066,39 @@ void C4Landscape::UpdatePixCnt(const C4Rect &Rect, bool fCheck)
 		}
 }
 
+bool C4Landscape::MatTileHasAny(int32_t x, int32_t y, const int32_t *piMats, int32_t iMatCnt) const
+{
+	const uint16_t *pTileCount = &MatTileCount[((y >> C4LS_TileShift) * MatTilesX + (x >> C4LS_TileShift)) * C4MaxMaterial];
+	for (int32_t i = 0; i < iMatCnt; i++)
+		if (pTileCount[piMats[i]])
+			return true;
+	return false;
+}
+
+void C4Landscape::UpdateSolidBits(C4Rect Rect)
+{
+	Rect.Intersect(C4Rect(0, 0, Width, Height));
+	for (int32_t y = Rect.y; y < Rect.y + Rect.Hgt; y++)
+		for (int32_t x = Rect.x; x < Rect.x + Rect.Wdt; x++)
+			_SetSolidBit(x, y, DensitySolid(_GetDensity(x, y)));
+}
+
 void C4Landscape::UpdateMatCnt(C4Rect Rect, bool fPlus)
 {
 	Rect.Intersect(C4Rect(0, 0, Width, Height));
 	if (!Rect.Hgt || !Rect.Wdt) return;
 	// Multiplicator for changes
 	const int32_t iMul = fPlus ? +1 : -1;
+	// Count pixels per tile
+	for (int32_t y = Rect.y; y < Rect.y + Rect.Hgt; y++)
+	{
+		uint16_t *pRowCount = &MatTileCount[(y >> C4LS_TileShift) * MatTilesX * C4MaxMaterial];
+		for (int32_t x = Rect.x; x < Rect.x + Rect.Wdt; x++)
+		{
+			int32_t iMat = _GetMat(x, y);
+			if (iMat >= 0) pRowCount[(x >> C4LS_TileShift) * C4MaxMaterial + iMat] += iMul;
+		}
+	}
 	// Count pixels
 	for (int32_t x = 0; x < Rect.Wdt; x++)
 	{
@@ -26,6 +26,9 @@
 #include <CSurface8.h>
 #include <C4Material.h>
 
+#include <memory>
+#include <vector>
+
 const int32_t C4MaxMaterial = 125;
 
 const int32_t C4LSC_Undefined = 0,
@@ -35,6 +38,31 @@ const int32_t C4LSC_Undefined = 0,
 
 const int32_t C4LS_MaxRelights = 50;
 
+const int32_t C4LS_TileShift = 6, // landscape tiles are 64x64 pixels
+              C4LS_TileSize = 1 << C4LS_TileShift;
+
+// 8bpp copy of a landscape surface, stored in tiles. Tiles of a single
+// color (sky, solid rock) only take one byte.
+class C4LandscapeTiles
+{
+public:
+	void Clear();
+	void Init(const CSurface8 &rSfc);
+	inline BYTE GetPix(int32_t x, int32_t y) const // bounds not checked
+	{
+		int32_t iTile = (y >> C4LS_TileShift) * TilesX + (x >> C4LS_TileShift);
+		const BYTE *pData = Tiles[iTile].get();
+		if (!pData) return Uniform[iTile];
+		return pData[((y & (C4LS_TileSize - 1)) << C4LS_TileShift) + (x & (C4LS_TileSize - 1))];
+	}
+	bool IsInitialized() const { return !Uniform.empty(); }
+
+private:
+	int32_t TilesX = 0;
+	std::vector<BYTE> Uniform; // color of single-color tiles
+	std::vector<std::unique_ptr<BYTE[]> > Tiles; // pixel data of other tiles
+};
+
 class C4Landscape
 {
 public:
@@ -56,8 +84,8 @@ public:
 	C4Sky Sky;
 	C4MapCreatorS2 *pMapCreator; // map creator for script-generated maps
 	bool fMapChanged;
-	BYTE *pInitial; // Initial landscape after creation - used for diff
-	BYTE *pInitialBkg; // Initial bkg landscape after creation - used for diff
+	C4LandscapeTiles Initial; // Initial landscape after creation - used for diff
+	C4LandscapeTiles InitialBkg; // Initial bkg landscape after creation - used for diff
 	class C4FoW *pFoW;
 
 private:
@@ -71,6 +99,10 @@ private:
 	bool Pix2Light[C4M_MaxTexIndex];
 	int32_t PixCntPitch;
 	uint8_t *PixCnt;
+	int32_t SolidBitsPitch; // words per row in SolidBits
+	uint32_t *SolidBits; // one bit per landscape pixel: set if solid
+	int32_t MatTilesX; // tiles per row in MatTileCount
+	std::vector<uint16_t> MatTileCount; // pixel count per material and landscape tile
 	C4Rect Relights[C4LS_MaxRelights];
 	mutable uint8_t *BridgeMatConversion[C4M_MaxTexIndex]; // NoSave //
 
@@ -112,6 +144,8 @@ public:
 	bool SetPix2(int32_t x, int32_t y, BYTE fgPix, BYTE bgPix); // set landscape pixel (bounds checked)
 	bool _SetPix2(int32_t x, int32_t y, BYTE fgPix, BYTE bgPix); // set landsape pixel (bounds not checked)
 	void _SetPix2Tmp(int32_t x, int32_t y, BYTE fgPix, BYTE bgPix); // set landsape pixel (bounds not checked, no material count updates, no landscape relighting). Material must be reset to original value with this function before modifying landscape in any other way. Only used for temporary pixel changes by SolidMask (C4SolidMask::RemoveTemporary, C4SolidMask::PutTemporary).
+	void PrepareSolidMaskChange(C4Rect BoundingBox); // before SolidMask put/remove by _SetPix2Tmp: uncount materials in rect
+	void FinishSolidMaskChange(C4Rect BoundingBox); // after SolidMask put/remove: recount materials and pixels, relight rect once
 	bool InsertMaterialOutsideLandscape(int32_t tx, int32_t ty, int32_t mdens); // return whether material insertion would be successful on an out-of-landscape position. Does not actually insert material.
 	bool InsertMaterial(int32_t mat, int32_t *tx, int32_t *ty, int32_t vx = 0, int32_t vy = 0, bool query_only=false); // modifies tx/ty to actual insertion position
 	bool InsertDeadMaterial(int32_t mat, int32_t tx, int32_t ty);
@@ -181,6 +215,16 @@ public:
 	{
 		return Pix2Place[GetPix(x, y)];
 	}
+	inline bool _GetSolid(int32_t x, int32_t y) const // get whether landscape is solid (bounds not checked)
+	{
+		return (SolidBits[y * SolidBitsPitch + (x >> 5)] >> (x & 31)) & 1;
+	}
+	inline bool GetSolid(int32_t x, int32_t y) const // get whether landscape is solid (bounds checked)
+	{
+		if (static_cast<uint32_t>(x) >= static_cast<uint32_t>(Width) || static_cast<uint32_t>(y) >= static_cast<uint32_t>(Height))
+			return GetDensity(x, y) >= C4M_Solid;
+		return _GetSolid(x, y);
+	}
 
 	inline BYTE _GetBackPix(int32_t x, int32_t y) const // get landscape pixel (bounds not checked)
 	{
@@ -258,6 +302,7 @@ public:
 	inline int32_t GetPixMat(BYTE byPix) const { return Pix2Mat[byPix]; }
 	inline int32_t GetPixDensity(BYTE byPix) const { return Pix2Dens[byPix]; }
 	bool _PathFree(int32_t x, int32_t y, int32_t x2, int32_t y2) const; // quickly checks wether there *might* be pixel in the path.
+	bool _FindSolidInRow(int32_t y, int32_t x, int32_t x2, int32_t *ix) const; // finds first solid pixel from x towards x2 (bounds not checked)
 	int32_t GetMatHeight(int32_t x, int32_t y, int32_t iYDir, int32_t iMat, int32_t iMax) const;
 
 	int32_t AreaSolidCount(int32_t x, int32_t y, int32_t wdt, int32_t hgt) const;
@@ -295,7 +340,15 @@ private:
 	bool CreateMapS2(C4Group &ScenFile, CSurface8*& sfcMap, CSurface8*& sfcMapBkg); // create map by def file
 	bool Mat2Pal(); // assign material colors to landscape palette
 	void UpdatePixCnt(const class C4Rect &Rect, bool fCheck = false);
+	void UpdateSolidBits(C4Rect Rect);
+	inline void _SetSolidBit(int32_t x, int32_t y, bool fSolid)
+	{
+		uint32_t &rWord = SolidBits[y * SolidBitsPitch + (x >> 5)];
+		if (fSolid) rWord |= 1u << (x & 31); else rWord &= ~(1u << (x & 31));
+	}
 	void UpdateMatCnt(C4Rect Rect, bool fPlus);
+	bool MatTileHasAny(int32_t x, int32_t y, const int32_t *piMats, int32_t iMatCnt) const; // whether the tile at x/y contains any of the given materials
+	void AddRelight(const C4Rect &Rect); // queue rect for relight and FoW invalidation
 	void PrepareChange(C4Rect BoundingBox);
 	void FinishChange(C4Rect BoundingBox);
 	bool DrawLineLandscape(int32_t iX, int32_t iY, int32_t iGrade, uint8_t line_color, uint8_t line_color_bkg);
@@ -402,7 +455,7 @@ inline int32_t GBackDensity(int32_t x, int32_t y)
 
 inline bool GBackSolid(int32_t x, int32_t y)
 {
-	return DensitySolid(GBackDensity(x,y));
+	return ::Landscape.GetSolid(x, y);
 }
 
 inline bool GBackSemiSolid(int32_t x, int32_t y)
@@ -930,11 +930,13 @@ void C4ParticleChunk::Clear()
 {
 	for (size_t i = 0; i < particleCount; ++i)
 	{
-		delete particles[i];
+		FreeParticle(particles[i]);
 	}
 	particleCount = 0;
 	particles.clear();
 	vertexCoordinates.clear();
+	freeParticles.clear();
+	particleBlocks.clear();
 
 	ClearBufferObjects();
 }
@@ -951,7 +953,30 @@ void C4ParticleChunk::DeleteAndReplaceParticle(size_t indexToReplace, size_t ind
 		particles[indexToReplace]->drawingData.SetPointer(&vertexCoordinates[indexToReplace * C4Particle::DrawingData::vertexCountPerParticle]);
 	}
 
-	delete oldParticle;
+	FreeParticle(oldParticle);
+}
+
+C4Particle *C4ParticleChunk::AllocateParticle()
+{
+	if (freeParticles.empty())
+	{
+		// grow geometrically so that a chunk only needs a few blocks over its lifetime
+		const size_t blockSize = std::max<size_t>(16, particles.size());
+		particleBlocks.emplace_back(new ParticleStorage[blockSize]);
+		ParticleStorage *block = particleBlocks.back().get();
+		freeParticles.reserve(freeParticles.size() + blockSize);
+		for (size_t i = blockSize; i > 0; --i)
+			freeParticles.push_back(reinterpret_cast<C4Particle*>(&block[i - 1]));
+	}
+	C4Particle *particle = freeParticles.back();
+	freeParticles.pop_back();
+	return new (particle) C4Particle();
+}
+
+void C4ParticleChunk::FreeParticle(C4Particle *particle)
+{
+	particle->~C4Particle();
+	freeParticles.push_back(particle);
 }
 
 bool C4ParticleChunk::Exec(C4Object *obj, float timeDelta)
@@ -1123,11 +1148,11 @@ C4Particle *C4ParticleChunk::AddNewParticle()
 
 	if (currentIndex < particles.size())
 	{
-		particles[currentIndex] = new C4Particle();
+		particles[currentIndex] = AllocateParticle();
 	}
 	else
 	{
-		particles.push_back(new C4Particle());
+		particles.push_back(AllocateParticle());
 		vertexCoordinates.resize(vertexCoordinates.size() + C4Particle::DrawingData::vertexCountPerParticle);
 	}
 
@@ -1337,9 +1362,23 @@ void C4ParticleSystem::ExecuteCalculation()
 
 		particleListAccessMutex.Enter();
 
+		// lists only touch their own particles (and read the landscape), so they can be simulated concurrently
+		std::vector<C4ParticleList *> lists;
+		lists.reserve(particleLists.size());
 		for (std::list<C4ParticleList>::iterator iter = particleLists.begin(); iter != particleLists.end(); ++iter)
+			lists.push_back(&*iter);
+
+		// threads are only worth waking if each of them gets some lists; list sizes vary a lot,
+		// so the pool hands out one list at a time
+		const unsigned int MinListsPerThread = 8;
+		if (C4WorkerPool::GetThreadCount() <= 1 || lists.size() < 2 * MinListsPerThread)
+		{
+			for (C4ParticleList *list : lists)
+				list->Exec(timeDelta);
+		}
+		else
 		{
-			iter->Exec(timeDelta);
+			calculationWorkers.ParallelFor(lists.size(), [&lists, timeDelta](size_t i) { lists[i]->Exec(timeDelta); });
 		}
 
 		particleListAccessMutex.Leave();
@@ -16,6 +16,9 @@
 #include <C4FacetEx.h>
 
 #include <StdScheduler.h>
+#include <C4WorkerPool.h>
+#include <memory>
+#include <type_traits>
 
 
 #ifndef INC_C4Particles
@@ -341,6 +344,13 @@ private:
 	std::vector<C4Particle::DrawingData::Vertex> vertexCoordinates;
 	size_t particleCount;
 
+	// particles are constructed in blocks owned by the chunk; the slots of dead particles are reused
+	typedef std::aligned_storage<sizeof(C4Particle), alignof(C4Particle)>::type ParticleStorage;
+	std::vector<std::unique_ptr<ParticleStorage[]> > particleBlocks;
+	std::vector<C4Particle*> freeParticles;
+	C4Particle *AllocateParticle();
+	void FreeParticle(C4Particle *particle);
+
 	// OpenGL optimizations
 	GLuint drawingDataVertexBufferObject;
 	GLuint drawingDataVertexArraysObject;
@@ -453,6 +463,7 @@ private:
 
 	CStdCSec particleListAccessMutex;
 	CStdEvent frameCounterAdvancedEvent;
+	C4WorkerPool calculationWorkers; // simulate particle lists in parallel; outlives calculationThread
 	CalculationThread calculationThread;
 
 	int currentSimulationTime; // in game time
@@ -66,7 +66,8 @@ const int32_t C4PF_MaxDepth        = 35,
               C4PF_Crawl_Right     = 2,
               C4PF_Crawl_Bottom    = 3,
               C4PF_Crawl_Left      = 4,
-              C4PF_Draw_Rate       = 10;
+              C4PF_Draw_Rate       = 10,
+              C4PF_CacheSize       = 64;
 
 //------------------------------- C4PathFinderRay ---------------------------------------------
 class C4PathFinderRay
@@ -221,18 +222,16 @@ bool C4PathFinderRay::Execute()
 		if ((X2==CrawlStartX) && (Y2==CrawlStartY) && (CrawlAttach==CrawlStartAttach))
 			{ Status=C4PF_Ray_Still; break; }
 		// Check unused zone intersection
-		if (pPathFinder->TransferZonesEnabled)
-			if (pPathFinder->TransferZones)
-				if ((pZone = pPathFinder->TransferZones->Find(X2,Y2)))
-					if (!pZone->Used)
-					{
-						// Add use-zone ray (with zone entry point adjust)
-						iX=X2; iY=Y2; if (pZone->GetEntryPoint(iX,iY,X2,Y2))
-							if (!pPathFinder->AddRay(iX,iY,TargetX,TargetY,Depth+1,Direction,this,pZone))
-								{ Status=C4PF_Ray_Failure; break; }
-						// Continue crawling
-						return true;
-					}
+		if ((pZone = pPathFinder->FindZone(X2,Y2)))
+			if (!pZone->Used)
+			{
+				// Add use-zone ray (with zone entry point adjust)
+				iX=X2; iY=Y2; if (pZone->GetEntryPoint(iX,iY,X2,Y2))
+					if (!pPathFinder->AddRay(iX,iY,TargetX,TargetY,Depth+1,Direction,this,pZone))
+						{ Status=C4PF_Ray_Failure; break; }
+				// Continue crawling
+				return true;
+			}
 		// Crawl length
 		CrawlLength++;
 		if (CrawlLength >= C4PF_MaxCrawl * pPathFinder->Level)
@@ -326,10 +325,8 @@ bool C4PathFinderRay::PathFree(int32_t &rX, int32_t &rY, int32_t iToX, int32_t i
 			else return false;
 			// Check transfer zone intersection
 			if (ppZone)
-				if (pPathFinder->TransferZonesEnabled)
-					if (pPathFinder->TransferZones)
-						if ((*ppZone = pPathFinder->TransferZones->Find(rX,rY)))
-							return false;
+				if ((*ppZone = pPathFinder->FindZone(rX,rY)))
+					return false;
 			// Advance
 			if (d>=0) { x+=xincr; d+=aincr; }
 			else d+=bincr;
@@ -348,10 +345,8 @@ bool C4PathFinderRay::PathFree(int32_t &rX, int32_t &rY, int32_t iToX, int32_t i
 			else return false;
 			// Check transfer zone intersection
 			if (ppZone)
-				if (pPathFinder->TransferZonesEnabled)
-					if (pPathFinder->TransferZones)
-						if ((*ppZone = pPathFinder->TransferZones->Find(rX,rY)))
-							return false;
+				if ((*ppZone = pPathFinder->FindZone(rX,rY)))
+					return false;
 			// Advance
 			if (d>=0) { y+=yincr; d+=aincr; }
 			else d+=bincr;
@@ -421,7 +416,7 @@ void C4PathFinderRay::SetCompletePath()
 
 bool C4PathFinderRay::PointFree(int32_t iX, int32_t iY)
 {
-	return pPathFinder->PointFree(iX,iY);
+	return pPathFinder->IsFree(iX,iY);
 }
 
 bool C4PathFinderRay::CrawlTargetFree(int32_t iX, int32_t iY, int32_t iAttach, int32_t iDirection)
@@ -551,6 +546,7 @@ void C4PathFinder::Default()
 	TransferZones=NULL;
 	TransferZonesEnabled=true;
 	Level=1;
+	ClearCache();
 }
 
 void C4PathFinder::Clear()
@@ -565,6 +561,7 @@ void C4PathFinder::Init(PointFreeFn fnPointFree, C4TransferZones* pTransferZones
 	// Set data
 	PointFree = fnPointFree;
 	TransferZones = pTransferZones;
+	ClearCache();
 }
 
 void C4PathFinder::EnableTransferZones(bool fEnabled)
@@ -626,21 +623,103 @@ bool C4PathFinder::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iT
 
 	// Parameter safety
 	if (!fnSetWaypoint) return false;
-	SetWaypoint=fnSetWaypoint;
 
-	// Start & target coordinates must be free
-	if (!PointFree(iFromX,iFromY) || !PointFree(iToX,iToY)) return false;
+	// Same search done before and nothing it looked at has changed: replay the result
+	int32_t iZoneChanges = (TransferZonesEnabled && TransferZones) ? TransferZones->GetChangeCount() : 0;
+	for (CacheEntry &rEntry : Cache)
+		if (rEntry.FromX == iFromX && rEntry.FromY == iFromY && rEntry.ToX == iToX && rEntry.ToY == iToY
+		    && rEntry.Level == Level && rEntry.TransferZonesEnabled == TransferZonesEnabled && rEntry.ZoneChanges == iZoneChanges)
+		{
+			for (size_t i = 0; i + 1 < rEntry.Waypoints.size(); i += 2)
+				fnSetWaypoint(rEntry.Waypoints[i], rEntry.Waypoints[i + 1], nullptr);
+			return rEntry.Success;
+		}
+
+	// Record probed area and waypoints of the search
+	RecordedWaypoints.clear();
+	SetWaypoint = [this, fnSetWaypoint](int32_t x, int32_t y, C4Object *transfer_object)
+	{
+		RecordedWaypoints.push_back(x); RecordedWaypoints.push_back(y);
+		return fnSetWaypoint(x, y, transfer_object);
+	};
+	ProbeX1 = ProbeX2 = iFromX; ProbeY1 = ProbeY2 = iFromY;
+	ZoneContact = false;
 
-	// Add the first two rays
-	if (!AddRay(iFromX,iFromY,iToX,iToY,0,C4PF_Direction_Left,NULL)) return false;
-	if (!AddRay(iFromX,iFromY,iToX,iToY,0,C4PF_Direction_Right,NULL)) return false;
+	// Start & target coordinates must be free
+	bool fSuccess = false;
+	if (IsFree(iFromX,iFromY) && IsFree(iToX,iToY))
+		// Add the first two rays
+		if (AddRay(iFromX,iFromY,iToX,iToY,0,C4PF_Direction_Left,NULL))
+			if (AddRay(iFromX,iFromY,iToX,iToY,0,C4PF_Direction_Right,NULL))
+			{
+				// Run
+				Run();
+				fSuccess = Success;
+			}
+	SetWaypoint = fnSetWaypoint;
 
-	// Run
-	Run();
+	// Remember result unless it depends on transfer zones or was drawn step by step
+	if (!ZoneContact && !::GraphicsSystem.ShowPathfinder)
+	{
+		CacheEntry Entry;
+		Entry.FromX = iFromX; Entry.FromY = iFromY; Entry.ToX = iToX; Entry.ToY = iToY;
+		Entry.Level = Level;
+		Entry.TransferZonesEnabled = TransferZonesEnabled;
+		Entry.ZoneChanges = iZoneChanges;
+		Entry.Success = fSuccess;
+		Entry.Probed.Set(ProbeX1, ProbeY1, ProbeX2 - ProbeX1 + 1, ProbeY2 - ProbeY1 + 1);
+		Entry.Waypoints.swap(RecordedWaypoints);
+		CacheArea.Add(Entry.Probed);
+		if (Cache.size() < size_t(C4PF_CacheSize))
+			Cache.push_back(std::move(Entry));
+		else
+			Cache[CacheNext] = std::move(Entry);
+		CacheNext = (CacheNext + 1) % C4PF_CacheSize;
+	}
 
 	// Success
-	return Success;
+	return fSuccess;
+}
 
+bool C4PathFinder::IsFree(int32_t iX, int32_t iY)
+{
+	// track searched area for cache invalidation
+	if (iX < ProbeX1) ProbeX1 = iX; else if (iX > ProbeX2) ProbeX2 = iX;
+	if (iY < ProbeY1) ProbeY1 = iY; else if (iY > ProbeY2) ProbeY2 = iY;
+	return PointFree(iX,iY);
+}
+
+C4TransferZone *C4PathFinder::FindZone(int32_t iX, int32_t iY)
+{
+	if (!TransferZonesEnabled || !TransferZones) return NULL;
+	C4TransferZone *pZone = TransferZones->Find(iX,iY);
+	// zone entry points depend on liquids and zone sizes: don't cache
+	if (pZone) ZoneContact = true;
+	return pZone;
+}
+
+void C4PathFinder::ClearCache()
+{
+	Cache.clear();
+	CacheNext = 0;
+	CacheArea.Default();
+}
+
+void C4PathFinder::OnLandscapeChange(const C4Rect &rRect)
+{
+	C4Rect Changed = rRect;
+	if (!CacheArea.Overlap(Changed)) return;
+	// drop affected entries and recompute the covered area
+	CacheArea.Default();
+	for (size_t i = 0; i < Cache.size(); )
+		if (Cache[i].Probed.Overlap(Changed))
+		{
+			Cache[i] = std::move(Cache.back());
+			Cache.pop_back();
+		}
+		else
+			CacheArea.Add(Cache[i++].Probed);
+	CacheNext = Cache.size() % C4PF_CacheSize;
 }
 
 bool C4PathFinder::AddRay(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iDepth, int32_t iDirection, C4PathFinderRay *pFrom, C4TransferZone *pUseZone)
@@ -21,6 +21,8 @@
 #define INC_C4PathFinder
 
 #include <functional>
+#include <vector>
+#include <C4Rect.h>
 
 class C4Object;
 class C4PathFinderRay;
@@ -41,12 +43,28 @@ public:
 	bool Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, SetWaypointFn fnSetWaypoint);
 	void EnableTransferZones(bool fEnabled);
 	void SetLevel(int iLevel);
+	void ClearCache();
+	void OnLandscapeChange(const C4Rect &rRect); // drop cached paths that probed the changed area
 
 private:
+	// exact result of a previous search without transfer zone contact
+	struct CacheEntry
+	{
+		int32_t FromX, FromY, ToX, ToY;
+		int Level;
+		bool TransferZonesEnabled;
+		int32_t ZoneChanges;
+		bool Success;
+		C4Rect Probed; // bounding box of all points checked by the search
+		std::vector<int32_t> Waypoints; // x,y pairs
+	};
+
 	void Run();
 	bool AddRay(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iDepth, int32_t iDirection, C4PathFinderRay *pFrom, C4TransferZone *pUseZone=NULL);
 	bool SplitRay(C4PathFinderRay *pRay, int32_t iAtX, int32_t iAtY);
 	bool Execute();
+	bool IsFree(int32_t iX, int32_t iY);
+	C4TransferZone *FindZone(int32_t iX, int32_t iY);
 
 	PointFreeFn PointFree;
 	SetWaypointFn SetWaypoint;
@@ -55,6 +73,14 @@ private:
 	C4TransferZones *TransferZones;
 	bool TransferZonesEnabled;
 	int Level;
+
+	// result cache
+	std::vector<CacheEntry> Cache;
+	size_t CacheNext;
+	C4Rect CacheArea; // union of all Probed rects
+	int32_t ProbeX1, ProbeY1, ProbeX2, ProbeY2;
+	bool ZoneContact;
+	std::vector<int32_t> RecordedWaypoints;
 };
 
 
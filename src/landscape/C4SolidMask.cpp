@@ -79,6 +79,7 @@ void C4SolidMask::Put(bool fCauseInstability, C4TargetRect *pClipRect, bool fRes
 			MaskPutRect.Hgt = std::min<int32_t>(oy + pForObject->SolidMask.Hgt, GBackHgt) - MaskPutRect.y;
 		}
 		// fill rect with mask
+		::Landscape.PrepareSolidMaskChange(*pClipRect);
 		for (ycnt=0; ycnt<pClipRect->Hgt; ++ycnt)
 		{
 			BYTE *pPix=pSolidMask->Bits + (ycnt+pClipRect->ty+pForObject->SolidMask.y)*pSolidMask->Pitch + pClipRect->tx + pForObject->SolidMask.x;
@@ -100,7 +101,7 @@ void C4SolidMask::Put(bool fCauseInstability, C4TargetRect *pClipRect, bool fRes
 							pSolidMaskMatBuff[(ycnt+pClipRect->ty)*MatBuffPitch+xcnt+pClipRect->tx]=byPixel;
 					}
 					// and set mask
-					::Landscape.SetPix2(iTx,iTy,MaskMaterial,::Landscape.Transparent);
+					::Landscape._SetPix2Tmp(iTx,iTy,MaskMaterial,::Landscape.Transparent);
 				}
 				else
 					// no SolidMask: mark buffer as unused here
@@ -132,6 +133,7 @@ void C4SolidMask::Put(bool fCauseInstability, C4TargetRect *pClipRect, bool fRes
 			MaskPutRect.Hgt = std::min<int32_t>(ystart + MatBuffPitch, GBackHgt) - MaskPutRect.y;
 		}
 		// go through clipping rect
+		::Landscape.PrepareSolidMaskChange(*pClipRect);
 		const C4Real y0 = itofix(pClipRect->ty - MatBuffPitch/2);
 		const C4Real x0 = itofix(pClipRect->tx - MatBuffPitch/2);
 		iTy=pClipRect->y;
@@ -166,7 +168,7 @@ void C4SolidMask::Put(bool fCauseInstability, C4TargetRect *pClipRect, bool fRes
 							pSolidMaskMatBuff[i + xcnt] = byPixel;
 					}
 					// set mask pix
-					::Landscape.SetPix2(iTx, iTy, MaskMaterial, ::Landscape.Transparent);
+					::Landscape._SetPix2Tmp(iTx, iTy, MaskMaterial, ::Landscape.Transparent);
 				}
 				else if (!MaskPut)
 					// mark pix as unused in buf
@@ -178,6 +180,8 @@ void C4SolidMask::Put(bool fCauseInstability, C4TargetRect *pClipRect, bool fRes
 			++iTy;
 		}
 	}
+	// material counts and relight for the whole put rect
+	::Landscape.FinishSolidMaskChange(*pClipRect);
 	// Store mask put status
 	MaskPut=true;
 	// restore attached object positions if moved
@@ -246,6 +250,7 @@ void C4SolidMask::Remove(bool fBackupAttachment)
 	CheckConsistency();
 
 	// reput background pixels
+	::Landscape.PrepareSolidMaskChange(MaskPutRect);
 	for (int ycnt=0; ycnt<MaskPutRect.Hgt; ++ycnt)
 	{
 		BYTE *pPix=pSolidMaskMatBuff+(ycnt+MaskPutRect.ty)*MatBuffPitch+MaskPutRect.tx;
@@ -261,11 +266,18 @@ void C4SolidMask::Remove(bool fBackupAttachment)
 				// temp remove SolidMasks before
 				assert(IsSomeVehicle(_GBackPix(iTx,iTy)));
 				if (IsSomeVehicle(::Landscape._GetPix(iTx, iTy)))
-					::Landscape._SetPix2(iTx, iTy, *pPix, ::Landscape.Transparent);
-				// Instability
-				::Landscape.CheckInstabilityRange(iTx,iTy);
+					::Landscape._SetPix2Tmp(iTx, iTy, *pPix, ::Landscape.Transparent);
 			}
 	}
+	::Landscape.FinishSolidMaskChange(MaskPutRect);
+	// Instability - after counts are updated, because it may change the landscape
+	for (int ycnt=0; ycnt<MaskPutRect.Hgt; ++ycnt)
+	{
+		BYTE *pPix=pSolidMaskMatBuff+(ycnt+MaskPutRect.ty)*MatBuffPitch+MaskPutRect.tx;
+		for (int xcnt=0; xcnt<MaskPutRect.Wdt; ++xcnt,++pPix)
+			if (*pPix != MCVehic)
+				::Landscape.CheckInstabilityRange(MaskPutRect.x+xcnt, MaskPutRect.y+ycnt);
+	}
 	// Mask not put flag
 	MaskPut=false;
 	// update surrounding masks in that range
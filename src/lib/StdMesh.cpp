@@ -17,6 +17,7 @@
 #include "C4Include.h"
 #include <StdMesh.h>
 #include <algorithm>
+#include <C4WorkerPool.h>
 
 namespace
 {
@@ -284,49 +285,83 @@ namespace
 	}
 }
 
+StdMeshKeyFrame& StdMeshTrack::AddFrame(float time)
+{
+	const unsigned int index = FindFrame(time);
+	if (index == Times.size() || Times[index] != time)
+	{
+		Times.insert(Times.begin() + index, time);
+		Frames.insert(Frames.begin() + index, StdMeshKeyFrame());
+	}
+	return Frames[index];
+}
+
+unsigned int StdMeshTrack::FindFrame(float time) const
+{
+	return std::lower_bound(Times.begin(), Times.end(), time) - Times.begin();
+}
+
 StdMeshTransformation StdMeshTrack::GetTransformAt(float time, float length) const
 {
-	std::map<float, StdMeshKeyFrame>::const_iterator iter = Frames.lower_bound(time);
+	unsigned int hint = 0;
+	return GetTransformAt(time, length, hint);
+}
+
+StdMeshTransformation StdMeshTrack::GetTransformAt(float time, float length, unsigned int& hint) const
+{
+	assert(!Times.empty());
+	const unsigned int count = Times.size();
+
+	// Animations mostly advance slowly, so the keyframe is usually the
+	// one of the previous lookup or the one after it.
+	unsigned int index = hint;
+	if (index > count || (index < count && Times[index] < time))
+		if (++index > count || (index < count && Times[index] < time))
+			index = FindFrame(time);
+	if (index > 0 && Times[index - 1] >= time)
+		index = FindFrame(time);
+	hint = index;
 
 	// We are at or before the first keyframe. This short typically not
 	// happen, since all animations have a keyframe 0. Simply return the
 	// first keyframe.
-	if (iter == Frames.begin())
-		return iter->second.Transformation;
+	if (index == 0)
+		return Frames[0].Transformation;
 
-	std::map<float, StdMeshKeyFrame>::const_iterator prev_iter = iter;
-	--prev_iter;
+	const unsigned int prev_index = index - 1;
 
 	float iter_pos;
-	if (iter == Frames.end())
+	if (index == count)
 	{
 		// We are beyond the last keyframe.
 		// Interpolate between the last and the first keyframe.
 		// See also bug #1406.
-		iter = Frames.begin();
+		index = 0;
 		iter_pos = length;
 	}
 	else
 	{
-		iter_pos = iter->first;
+		iter_pos = Times[index];
 	}
 
+	const float prev_pos = Times[prev_index];
+
 	// No two keyframes with the same position:
-	assert(iter_pos > prev_iter->first);
+	assert(iter_pos > prev_pos);
 
 	// Requested position is between the two selected keyframes:
-	assert(time >= prev_iter->first);
+	assert(time >= prev_pos);
 	assert(iter_pos >= time);
 
-	float dt = iter_pos - prev_iter->first;
-	float weight1 = (time - prev_iter->first) / dt;
+	float dt = iter_pos - prev_pos;
+	float weight1 = (time - prev_pos) / dt;
 	float weight2 = (iter_pos - time) / dt;
 	(void)weight2; // used in assertion only
 
 	assert(weight1 >= 0 && weight2 >= 0 && weight1 <= 1 && weight2 <= 1);
 	assert(fabs(weight1 + weight2 - 1) < 1e-6);
 
-	return StdMeshTransformation::Nlerp(prev_iter->second.Transformation, iter->second.Transformation, weight1);
+	return StdMeshTransformation::Nlerp(Frames[prev_index].Transformation, Frames[index].Transformation, weight1);
 }
 
 StdMeshAnimation::StdMeshAnimation(const StdMeshAnimation& other):
@@ -446,12 +481,12 @@ void StdMeshSkeleton::MirrorAnimation(const StdMeshAnimation& animation)
 
 				// Mirror all the keyframes of both tracks
 				if (new_anim.Tracks[i] != NULL)
-					for (std::map<float, StdMeshKeyFrame>::iterator iter = new_anim.Tracks[i]->Frames.begin(); iter != new_anim.Tracks[i]->Frames.end(); ++iter)
-						MirrorKeyFrame(iter->second, own_trans, StdMeshTransformation::Inverse(other_own_trans));
+					for (StdMeshKeyFrame& frame : new_anim.Tracks[i]->Frames)
+						MirrorKeyFrame(frame, own_trans, StdMeshTransformation::Inverse(other_own_trans));
 
 				if (new_anim.Tracks[other_bone->Index] != NULL)
-					for (std::map<float, StdMeshKeyFrame>::iterator iter = new_anim.Tracks[other_bone->Index]->Frames.begin(); iter != new_anim.Tracks[other_bone->Index]->Frames.end(); ++iter)
-						MirrorKeyFrame(iter->second, other_own_trans, StdMeshTransformation::Inverse(own_trans));
+					for (StdMeshKeyFrame& frame : new_anim.Tracks[other_bone->Index]->Frames)
+						MirrorKeyFrame(frame, other_own_trans, StdMeshTransformation::Inverse(own_trans));
 			}
 		}
 		else if (bone.Name.Compare_(".N", bone.Name.getLength() - 2) != 0)
@@ -461,8 +496,8 @@ void StdMeshSkeleton::MirrorAnimation(const StdMeshAnimation& animation)
 				StdMeshTransformation own_trans = bone.Transformation;
 				if (bone.GetParent()) own_trans = bone.GetParent()->InverseTransformation * bone.Transformation;
 
-				for (std::map<float, StdMeshKeyFrame>::iterator iter = new_anim.Tracks[i]->Frames.begin(); iter != new_anim.Tracks[i]->Frames.end(); ++iter)
-					MirrorKeyFrame(iter->second, own_trans, StdMeshTransformation::Inverse(own_trans));
+				for (StdMeshKeyFrame& frame : new_anim.Tracks[i]->Frames)
+					MirrorKeyFrame(frame, own_trans, StdMeshTransformation::Inverse(own_trans));
 			}
 		}
 	}
@@ -818,7 +853,8 @@ bool StdMeshInstance::AnimationNode::GetBoneTransform(unsigned int bone, StdMesh
 	case LeafNode:
 		track = Leaf.Animation->Tracks[bone];
 		if (!track) return false;
-		transformation = track->GetTransformAt(fixtof(Leaf.Position->Value), Leaf.Animation->Length);
+		if (FrameHints.size() <= bone) FrameHints.resize(Leaf.Animation->Tracks.size());
+		transformation = track->GetTransformAt(fixtof(Leaf.Position->Value), Leaf.Animation->Length, FrameHints[bone]);
 		return true;
 	case CustomNode:
 		if(bone == Custom.BoneIndex)
@@ -1054,7 +1090,7 @@ StdMeshInstance::StdMeshInstance(const StdMesh& mesh, float completion):
 		Mesh(&mesh), Completion(completion),
 		BoneTransforms(Mesh->GetSkeleton().GetNumBones(), StdMeshMatrix::Identity()),
 		SubMeshInstances(Mesh->GetNumSubMeshes()), AttachParent(NULL),
-		BoneTransformsDirty(false)
+		BoneTransformsDirty(false), TextureAnimationTime(0.0f)
 {
 	// Create submesh instances
 	for (unsigned int i = 0; i < Mesh->GetNumSubMeshes(); ++i)
@@ -1257,6 +1293,21 @@ void StdMeshInstance::ExecuteAnimation(float dt)
 			StopAnimation(AnimationStack[i-1]);
 
 #ifndef USE_CONSOLE
+	// Animated textures are only visible when drawn
+	TextureAnimationTime += dt;
+#endif
+
+	// Update animation for attached meshes
+	for (AttachedMeshList::iterator iter = AttachChildren.begin(); iter != AttachChildren.end(); ++iter)
+		(*iter)->Child->ExecuteAnimation(dt);
+}
+
+void StdMeshInstance::UpdateTextureAnimation()
+{
+#ifndef USE_CONSOLE
+	const float dt = TextureAnimationTime;
+	TextureAnimationTime = 0.0f;
+
 	// Update animated textures
 	for (unsigned int i = 0; i < SubMeshInstances.size(); ++i)
 	{
@@ -1287,11 +1338,11 @@ void StdMeshInstance::ExecuteAnimation(float dt)
 			}
 		}
 	}
-#endif
 
-	// Update animation for attached meshes
+	// Attached meshes are rendered with this one
 	for (AttachedMeshList::iterator iter = AttachChildren.begin(); iter != AttachChildren.end(); ++iter)
-		(*iter)->Child->ExecuteAnimation(dt);
+		(*iter)->Child->UpdateTextureAnimation();
+#endif
 }
 
 StdMeshInstance::AttachedMesh* StdMeshInstance::AttachMesh(const StdMesh& mesh, AttachedMesh::Denumerator* denumerator, const StdStrBuf& parent_bone, const StdStrBuf& child_bone, const StdMeshMatrix& transformation, uint32_t flags, unsigned int attach_number)
@@ -1514,6 +1565,27 @@ bool StdMeshInstance::UpdateBoneTransforms()
 	return was_dirty;
 }
 
+void StdMeshInstance::UpdateBoneTransforms(const std::vector<StdMeshInstance*>& instances)
+{
+	// Instances only touch their own animation nodes and bone matrices and
+	// those of their attached children, so they can be updated concurrently.
+	// Waking the workers is only worth it if there are enough bones to go around.
+	const size_t MinBonesPerThread = 512;
+	size_t bone_count = 0;
+	for (StdMeshInstance* instance : instances)
+		bone_count += instance->Mesh->GetSkeleton().GetNumBones();
+	if (C4WorkerPool::GetThreadCount() <= 1 || bone_count < 2 * MinBonesPerThread)
+	{
+		for (StdMeshInstance* instance : instances)
+			instance->UpdateBoneTransforms();
+		return;
+	}
+
+	// the workers stay around between frames
+	static C4WorkerPool workers;
+	workers.ParallelFor(instances.size(), [&instances](size_t i) { instances[i]->UpdateBoneTransforms(); });
+}
+
 void StdMeshInstance::ReorderFaces(StdMeshMatrix* global_trans)
 {
 #ifndef USE_CONSOLE
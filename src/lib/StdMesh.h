@@ -76,9 +76,16 @@ class StdMeshTrack
 	friend class StdMeshSkeletonLoader;
 public:
 	StdMeshTransformation GetTransformAt(float time, float length) const;
+	// hint is the keyframe index found in the previous lookup, updated for the next one
+	StdMeshTransformation GetTransformAt(float time, float length, unsigned int& hint) const;
 
 private:
-	std::map<float, StdMeshKeyFrame> Frames;
+	StdMeshKeyFrame& AddFrame(float time); // get keyframe at time, inserting it if necessary
+	unsigned int FindFrame(float time) const; // index of first keyframe at or after time
+
+	// keyframes sorted by time; kept in two arrays so that lookup only touches the times
+	std::vector<float> Times;
+	std::vector<StdMeshKeyFrame> Frames;
 };
 
 // Animation, consists of one Track for each animated Bone
@@ -437,6 +444,7 @@ public:
 		unsigned int Number;
 		NodeType Type;
 		AnimationNode* Parent; // NoSave
+		std::vector<unsigned int> FrameHints; // NoSave; last keyframe index per bone for leaf nodes
 
 		union
 		{
@@ -549,9 +557,14 @@ public:
 	void SetAnimationWeight(AnimationNode* node, ValueProvider* weight);
 
 	// Update animations; call once a frame
-	// dt is used for texture animation, skeleton animation is updated via value providers
+	// dt is used for texture animation, skeleton animation is updated via value providers.
+	// Only the animation positions are updated here; bone transformations are computed by
+	// UpdateBoneTransforms and texture animation is applied by UpdateTextureAnimation on demand.
 	void ExecuteAnimation(float dt);
 
+	// Apply texture animation time that passed since the last call; call once before rendering
+	void UpdateTextureAnimation();
+
 	// Create a new instance and attach it to this mesh. Takes ownership of denumerator
 	AttachedMesh* AttachMesh(const StdMesh& mesh, AttachedMesh::Denumerator* denumerator, const StdStrBuf& parent_bone, const StdStrBuf& child_bone, const StdMeshMatrix& transformation = StdMeshMatrix::Identity(), uint32_t flags = AM_None, unsigned int attach_number = 0);
 	// Attach an instance to this instance. Takes ownership of denumerator. If own_child is true deletes instance on detach.
@@ -583,6 +596,10 @@ public:
 	// mesh was deformed since the last execution, or false otherwise.
 	bool UpdateBoneTransforms();
 
+	// Update bone transformations of many instances at once, distributing them to several threads if there
+	// are enough of them. The instances must not be attached to a parent, and no instance may appear twice.
+	static void UpdateBoneTransforms(const std::vector<StdMeshInstance*>& instances);
+
 	// Orders faces according to current face ordering. Clal this once before rendering if one of the following is true:
 	//
 	// a) the call to UpdateBoneTransforms returns true
@@ -633,6 +650,7 @@ protected:
 	AttachedMesh* AttachParent;
 
 	bool BoneTransformsDirty;
+	float TextureAnimationTime; // NoSave; time for texture animation not yet applied
 private:
 	StdMeshInstance(const StdMeshInstance& other); // noncopyable
 	StdMeshInstance& operator=(const StdMeshInstance& other); // noncopyable
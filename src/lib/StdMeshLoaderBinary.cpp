@@ -412,7 +412,7 @@ void StdMeshSkeletonLoader::LoadSkeletonBinary(const char* groupname, const char
 			track = new StdMeshTrack;
 			for(auto &catkf: catrack->keyframes)
 			{
-				StdMeshKeyFrame &kf = track->Frames[catkf->time];
+				StdMeshKeyFrame &kf = track->AddFrame(catkf->time);
 				kf.Transformation.rotate = catkf->rotation;
 				kf.Transformation.scale = catkf->scale;
 				kf.Transformation.translate = bone.InverseTransformation.rotate * (bone.InverseTransformation.scale * catkf->translation);
@@ -29,9 +29,10 @@
 C4GameControlNetwork::C4GameControlNetwork(C4GameControl *pnParent)
 		: fEnabled(false), fRunning(false), iClientID(C4ClientIDUnknown),
 		fActivated(false), iTargetTick(-1),
-		iControlPreSend(1), tWaitStart(C4TimeMilliseconds::PositiveInfinity), iAvgControlSendTime(0), iTargetFPS(38),
+		iControlPreSend(1), tWaitStart(C4TimeMilliseconds::PositiveInfinity), iControlWaitTime(0), iAvgControlSendTime(0), iTargetFPS(38),
+		tLastPreSendDec(0), iAvgControlWait(0), iPacingDelay(0),
 		iControlSent(0), iControlReady(0),
-		pCtrlStack(NULL),
+		pCtrlRings(NULL), pCtrlStack(NULL),
 		tNextControlRequest(0),
 		pParent(pnParent)
 {
@@ -59,6 +60,7 @@ bool C4GameControlNetwork::Init(int32_t inClientID, bool fnHost, int32_t iStartT
 	// ok
 	fEnabled = true; fRunning = false;
 	iTargetFPS = 38;
+	iAvgControlWait = 0; iPacingDelay = 0;
 	tNextControlRequest = C4TimeMilliseconds::Now() + C4ControlRequestInterval;
 	tWaitStart = C4TimeMilliseconds::PositiveInfinity;
 	return true;
@@ -68,6 +70,7 @@ void C4GameControlNetwork::Clear() // by main thread
 {
 	fEnabled = false; fRunning = false;
 	iAvgControlSendTime = 0;
+	iAvgControlWait = 0; iPacingDelay = 0;
 	ClearCtrl(); ClearClients();
 	// clear sync control
 	SyncControl.Clear();
@@ -86,7 +89,8 @@ void C4GameControlNetwork::Execute() // by main thread
 		return;
 
 	// Save time the control tick was reached
-	tWaitStart = C4TimeMilliseconds::Now();
+	if (tWaitStart == C4TimeMilliseconds::PositiveInfinity)
+		tWaitStart = C4TimeMilliseconds::Now();
 
 	// Execute any queued sync control
 	ExecQueuedSyncCtrl();
@@ -113,6 +117,20 @@ bool C4GameControlNetwork::GetControl(C4Control *pCtrl, int32_t iTick) // by mai
 	pCtrl->Append(pPkt->getControl());
 	// calc performance
 	CalcPerformance(iTick);
+	if (tWaitStart != C4TimeMilliseconds::PositiveInfinity)
+	{
+		uint32_t iWait = C4TimeMilliseconds::Now() - tWaitStart;
+		iControlWaitTime += iWait;
+		// host: rather slow down the game a little than stall hard while control keeps arriving late
+		if (fHost)
+		{
+			// limit single long waits (pauses, synchronization), rise fast, decay slowly
+			int32_t iRate = std::max<int32_t>(pParent->ControlRate, 1);
+			int32_t iWait16 = std::min<int32_t>(iWait, C4ControlMaxPacingDelay * iRate * 2) * 16;
+			iAvgControlWait += (iWait16 - iAvgControlWait) / (iWait16 > iAvgControlWait ? 4 : 16);
+			iPacingDelay = std::min<uint32_t>(iAvgControlWait / 16 / iRate, C4ControlMaxPacingDelay);
+		}
+	}
 	tWaitStart = C4TimeMilliseconds::PositiveInfinity;
 	// ok
 	return true;
@@ -143,6 +161,19 @@ int32_t C4GameControlNetwork::ClientNextControl(int32_t iClientID) // by main th
 	return pClient ? pClient->getNextControl() : 0;
 }
 
+bool C4GameControlNetwork::GetClientLatency(int32_t iClientID, int32_t *piAvg, int32_t *piJitter, int32_t *piHigh) // by main thread
+{
+	// get client
+	CStdLock ClientsLock(&ClientsCSec);
+	C4GameControlClient *pClient = getClient(iClientID);
+	if (!pClient || !pClient->HasPing()) return false;
+	// return latency model
+	*piAvg = pClient->getAvgPing();
+	*piJitter = pClient->getPingJitter();
+	*piHigh = pClient->getPingPercentile(90);
+	return true;
+}
+
 bool C4GameControlNetwork::CtrlNeeded(int32_t iFrame) const // by main thread
 {
 	if (!IsEnabled() || !fActivated) return false;
@@ -176,7 +207,7 @@ void C4GameControlNetwork::DoInput(const C4Control &Input) // by main thread
 			Application.InteractiveThread.ThreadLog("Failed to broadcast control!");
 	}
 	// add to list
-	AddCtrl(pCtrl);
+	if (!AddCtrl(pCtrl)) delete pCtrl;
 	// ok, control is sent for this control tick
 	iControlSent++;
 	// ctrl complete?
@@ -287,9 +318,8 @@ void C4GameControlNetwork::ExecSyncControl(int32_t iControlTick) // by main thre
 	if (!SyncControl.firstPkt())
 		return;
 
-	// Copy control and clear
-	C4Control Control = SyncControl;
-	SyncControl.Clear();
+	// Take over control
+	C4Control Control; Control.Take(SyncControl);
 
 	// Given control tick reached?
 	if (pParent->ControlTick == iControlTick)
@@ -394,7 +424,7 @@ void C4GameControlNetwork::CalcPerformance(int32_t iCtrlTick)
 	// should only be called if ready
 	assert(CtrlReady(iCtrlTick));
 	// calc perfomance for all clients
-	int32_t iClientsPing=0; int32_t iPingClientCount=0; int32_t iNumTunnels=0; int32_t iHostPing=0;
+	int32_t iClientsLatency=0; int32_t iNumTunnels=0; int32_t iHostLatency=0;
 	for (C4GameControlClient *pClient = pClients; pClient; pClient = pClient->pNext)
 	{
 		// Some rudimentary PreSend-calculation
@@ -407,14 +437,15 @@ void C4GameControlNetwork::CalcPerformance(int32_t iCtrlTick)
 				// remember tunnel
 				++iNumTunnels;
 			else
-				// store ping
+			{
+				// update latency model
+				pClient->AddPing(pConn->getPingTime());
+				// the slowest client decides when control must be sent
 				if (pClient->getClientID() == C4ClientIDHost)
-					iHostPing = pConn->getPingTime();
+					iHostLatency = pClient->getLatency();
 				else
-				{
-					iClientsPing += pConn->getPingTime();
-					++iPingClientCount;
-				}
+					iClientsLatency = std::max(iClientsLatency, pClient->getLatency());
+			}
 		}
 		// Performance statistics
 		// find control (may not be found, if we only got the complete ctrl)
@@ -423,33 +454,41 @@ void C4GameControlNetwork::CalcPerformance(int32_t iCtrlTick)
 		// calc stats
 		pClient->AddPerf(pCtrl->getTime() - tWaitStart);
 	}
-	// Now do PreSend-calcs based on ping times
+	// Now do PreSend-calcs based on latencies
 	int32_t iControlSendTime;
 	if (eMode == CNM_Decentral)
 	{
-		// average ping time
-		iControlSendTime = (iClientsPing + iHostPing * (iNumTunnels + 1)) / (iPingClientCount + iNumTunnels + 1);
-		// decentral mode: Only half the ping is used if there are no tunnels
-		if (!iNumTunnels) iControlSendTime /= 2;
+		// decentral mode: Only half the ping is used for direct connections
+		iControlSendTime = std::max(iClientsLatency, iHostLatency) / 2;
+		// tunneled control must go to host and back
+		if (iNumTunnels) iControlSendTime = std::max(iControlSendTime, iHostLatency);
 	}
 	else
 	{
 		// central mode: Control must go to host and back
-		iControlSendTime = iHostPing;
+		iControlSendTime = iHostLatency;
 	}
 	// calc some average
 	if (iControlSendTime)
 	{
 		iAvgControlSendTime = (iAvgControlSendTime * 149 + iControlSendTime * 1000) / 150;
-		// now calculate the all-time optimum PreSend there is
-		int32_t iBestPreSend = Clamp((iTargetFPS * iAvgControlSendTime) / 1000000 + 1, 1, 15);
-		// fixed PreSend?
-		if (iTargetFPS <= 0) iBestPreSend = -iTargetFPS;
+		// now calculate the PreSend needed for the current latency
+		int32_t iBestPreSend = Clamp((iTargetFPS * iControlSendTime) / 1000 + 1, 1, C4MaxPreSend);
+		// adapt smoothly: raise by one frame per control tick, lower only slowly
+		int32_t iPreSend = getControlPreSend();
+		C4TimeMilliseconds tNow = C4TimeMilliseconds::Now();
+		if (iTargetFPS <= 0)
+			// fixed PreSend
+			iPreSend = -iTargetFPS;
+		else if (iBestPreSend > iPreSend)
+			{ iPreSend++; tLastPreSendDec = tNow; }
+		else if (iBestPreSend < iPreSend && tNow >= tLastPreSendDec + C4ControlPreSendDecInterval)
+			{ iPreSend--; tLastPreSendDec = tNow; }
 		// Ha! Set it!
-		if (getControlPreSend() != iBestPreSend)
+		if (getControlPreSend() != iPreSend)
 		{
-			setControlPreSend(iBestPreSend);
-			::GraphicsSystem.FlashMessage(FormatString("PreSend: %d  - TargetFPS: %d", iBestPreSend, iTargetFPS).getData());
+			setControlPreSend(iPreSend);
+			::GraphicsSystem.FlashMessage(FormatString("PreSend: %d  - TargetFPS: %d", iPreSend, iTargetFPS).getData());
 		}
 	}
 }
@@ -470,7 +509,9 @@ void C4GameControlNetwork::HandlePacket(char cStatus, const C4PacketBase *pPacke
 	case PID_Control: // control
 	{
 		GETPKT(C4GameControlPacket, rPkt)
-		HandleControl(pConn->getClientID(), rPkt);
+		// the packet might be needed by other handlers: take over a copy
+		C4GameControlPacket Pkt(rPkt);
+		HandleControl(pConn->getClientID(), Pkt);
 	}
 	break;
 
@@ -516,6 +557,18 @@ void C4GameControlNetwork::HandlePacket(char cStatus, const C4PacketBase *pPacke
 #undef GETPKT
 }
 
+void C4GameControlNetwork::HandlePacket(char cStatus, C4PacketBase *pPacket, C4Network2IOConnection *pConn)
+{
+	// control is taken over from the packet instead of copied
+	if (cStatus == PID_Control && pConn)
+	{
+		assert(pPacket);
+		HandleControl(pConn->getClientID(), static_cast<C4GameControlPacket &>(*pPacket));
+	}
+	else
+		HandlePacket(cStatus, static_cast<const C4PacketBase *>(pPacket), pConn);
+}
+
 void C4GameControlNetwork::OnResComplete(C4Network2Res *pRes)
 {
 	// player?
@@ -524,13 +577,14 @@ void C4GameControlNetwork::OnResComplete(C4Network2Res *pRes)
 		CheckCompleteCtrl(true);
 }
 
-void C4GameControlNetwork::HandleControl(int32_t iByClientID, const C4GameControlPacket &rPkt)
+void C4GameControlNetwork::HandleControl(int32_t iByClientID, C4GameControlPacket &rPkt)
 {
 	// already got that control? just ignore
 	if (getCtrl(rPkt.getClientID(), rPkt.getCtrlTick())) return;
-	// create copy, add to list
-	C4GameControlPacket *pCopy = new C4GameControlPacket(rPkt);
-	AddCtrl(pCopy);
+	// take over control, add to list
+	C4GameControlPacket *pCtrl = new C4GameControlPacket();
+	pCtrl->Take(rPkt.getClientID(), rPkt.getCtrlTick(), rPkt.Ctrl);
+	if (!AddCtrl(pCtrl)) { delete pCtrl; return; }
 	// check: control complete?
 	if (IsEnabled())
 		CheckCompleteCtrl(true);
@@ -554,6 +608,12 @@ void C4GameControlNetwork::HandleControlReq(const C4PacketControlReq &rPkt, C4Ne
 		// send everything we have for this tick (this is an emergency case, so efficiency
 		// isn't that important for now).
 		bool fFound = false;
+		for (C4GameControlRing *pRing = pCtrlRings; pRing; pRing = pRing->pNext)
+			if ((pCtrl = pRing->getCtrl(iTick)))
+			{
+				pConn->Send(MkC4NetIOPacket(PID_Control, *pCtrl));
+				fFound = true;
+			}
 		for (pCtrl = pCtrlStack; pCtrl; pCtrl = pCtrl->pNext)
 			if (pCtrl->getCtrlTick() == iTick)
 			{
@@ -646,27 +706,65 @@ C4GameControlPacket *C4GameControlNetwork::getCtrl(int32_t iClientID, int32_t iC
 {
 	// lock
 	CStdLock CtrlLock(&CtrlCSec);
-	// search
-	for (C4GameControlPacket *pCtrl = pCtrlStack; pCtrl; pCtrl = pCtrl->pNext)
+	// look up the client's ring
+	C4GameControlRing *pRing = getCtrlRing(iClientID);
+	C4GameControlPacket *pCtrl = pRing ? pRing->getCtrl(iCtrlTick) : NULL;
+	if (pCtrl) return pCtrl;
+	// search overflow
+	for (pCtrl = pCtrlStack; pCtrl; pCtrl = pCtrl->pNext)
 		if (pCtrl->getClientID() == iClientID && pCtrl->getCtrlTick() == iCtrlTick)
 			return pCtrl;
 	return NULL;
 }
 
-void C4GameControlNetwork::AddCtrl(C4GameControlPacket *pCtrl) // by both
+C4GameControlRing *C4GameControlNetwork::getCtrlRing(int32_t iClientID, bool fCreate) // by both
 {
 	// lock
 	CStdLock CtrlLock(&CtrlCSec);
-	// add to list
+	// search
+	for (C4GameControlRing *pRing = pCtrlRings; pRing; pRing = pRing->pNext)
+		if (pRing->getClientID() == iClientID)
+			return pRing;
+	if (!fCreate) return NULL;
+	// create new
+	C4GameControlRing *pRing = new C4GameControlRing(iClientID);
+	pRing->pNext = pCtrlRings;
+	pCtrlRings = pRing;
+	return pRing;
+}
+
+bool C4GameControlNetwork::AddCtrl(C4GameControlPacket *pCtrl) // by both
+{
+	// lock
+	CStdLock CtrlLock(&CtrlCSec);
+	// already got that control?
+	if (getCtrl(pCtrl->getClientID(), pCtrl->getCtrlTick()))
+		return false;
+	// add to ring
+	if (getCtrlRing(pCtrl->getClientID(), true)->Add(pCtrl))
+		return true;
+	// slot still in use (control far out of the backlog window): add to overflow list
 	pCtrl->pNext = pCtrlStack;
 	pCtrlStack = pCtrl;
+	return true;
 }
 
 void C4GameControlNetwork::ClearCtrl(int32_t iBeforeTick) // by main thread
 {
 	// lock
 	CStdLock CtrlLock(&CtrlCSec);
-	// clear all old control
+	// clear rings
+	if (iBeforeTick == -1)
+		while (pCtrlRings)
+		{
+			C4GameControlRing *pDelete = pCtrlRings;
+			pCtrlRings = pDelete->pNext;
+			delete pDelete;
+		}
+	else
+		for (C4GameControlRing *pRing = pCtrlRings; pRing; pRing = pRing->pNext)
+			pRing->Clear(iBeforeTick);
+	// clear all old control from overflow
 	C4GameControlPacket *pCtrl = pCtrlStack, *pLast = NULL;
 	while (pCtrl)
 	{
@@ -788,7 +886,8 @@ C4GameControlPacket *C4GameControlNetwork::PackCompleteCtrl(int32_t iTick)
 		}
 
 	// add to list
-	AddCtrl(pComplete);
+	if (!AddCtrl(pComplete))
+		{ delete pComplete; return getCtrl(C4ClientIDAll, iTick); }
 
 	// host: send to clients (central and async mode)
 	if (eMode != CNM_Decentral)
@@ -801,7 +900,7 @@ C4GameControlPacket *C4GameControlNetwork::PackCompleteCtrl(int32_t iTick)
 	return pComplete;
 }
 
-void C4GameControlNetwork::AddSyncCtrlToQueue(const C4Control &Ctrl, int32_t iTick)  // by main thread
+void C4GameControlNetwork::AddSyncCtrlToQueue(C4Control &Ctrl, int32_t iTick)  // by main thread
 {
 	// search place in queue. It's vitally important that new packets are placed
 	// behind packets for the same tick, so they will be executed in the right order.
@@ -810,7 +909,7 @@ void C4GameControlNetwork::AddSyncCtrlToQueue(const C4Control &Ctrl, int32_t iTi
 		{ pAfter = pBefore; pBefore = pBefore->pNext; }
 	// create
 	C4GameControlPacket *pnPkt = new C4GameControlPacket();
-	pnPkt->Set(C4ClientIDUnknown, iTick, Ctrl);
+	pnPkt->Take(C4ClientIDUnknown, iTick, Ctrl);
 	// insert
 	(pAfter ? pAfter->pNext : pSyncCtrlQueue) = pnPkt;
 	pnPkt->pNext = pBefore;
@@ -885,6 +984,14 @@ void C4GameControlPacket::Set(int32_t inClientID, int32_t inCtrlTick, const C4Co
 	Ctrl.Copy(nCtrl);
 }
 
+void C4GameControlPacket::Take(int32_t inClientID, int32_t inCtrlTick, C4Control &nCtrl)
+{
+	iClientID = inClientID;
+	iCtrlTick = inCtrlTick;
+	Ctrl.Clear();
+	Ctrl.Take(nCtrl);
+}
+
 void C4GameControlPacket::Add(const C4GameControlPacket &Ctrl2)
 {
 	Ctrl.Append(Ctrl2.getControl());
@@ -897,10 +1004,48 @@ void C4GameControlPacket::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(Ctrl, "Ctrl"));
 }
 
+// *** C4GameControlRing
+
+C4GameControlRing::C4GameControlRing(int32_t inClientID)
+		: iClientID(inClientID), pNext(NULL)
+{
+	std::fill_n(pSlots, C4ControlRingSize, static_cast<C4GameControlPacket *>(NULL));
+}
+
+C4GameControlRing::~C4GameControlRing()
+{
+	Clear();
+}
+
+C4GameControlPacket *C4GameControlRing::getCtrl(int32_t iCtrlTick) const
+{
+	C4GameControlPacket *pCtrl = pSlots[getSlot(iCtrlTick)];
+	return pCtrl && pCtrl->getCtrlTick() == iCtrlTick ? pCtrl : NULL;
+}
+
+bool C4GameControlRing::Add(C4GameControlPacket *pCtrl)
+{
+	C4GameControlPacket *&pSlot = pSlots[getSlot(pCtrl->getCtrlTick())];
+	if (pSlot) return false;
+	pSlot = pCtrl;
+	return true;
+}
+
+void C4GameControlRing::Clear(int32_t iBeforeTick)
+{
+	for (int32_t i = 0; i < C4ControlRingSize; i++)
+		if (pSlots[i] && (iBeforeTick == -1 || pSlots[i]->getCtrlTick() < iBeforeTick))
+		{
+			delete pSlots[i];
+			pSlots[i] = NULL;
+		}
+}
+
 // *** C4GameControlClient
 
 C4GameControlClient::C4GameControlClient()
-		: iClientID(C4ClientIDUnknown), iNextControl(0), iPerformance(0)
+		: iClientID(C4ClientIDUnknown), iNextControl(0), iPerformance(0),
+		iAvgPing(0), iPingJitter(0), iPingSampleCnt(0), tNextPingSample(0)
 {
 	szName[0] = '\0';
 }
@@ -920,3 +1065,42 @@ void C4GameControlClient::AddPerf(int32_t iTime)
 {
 	iPerformance += (iTime * 100 - iPerformance) / 100;
 }
+
+void C4GameControlClient::AddPing(int32_t iPing)
+{
+	// no ping yet? pings are only measured every now and then
+	C4TimeMilliseconds tNow = C4TimeMilliseconds::Now();
+	if (iPing < 0 || tNow < tNextPingSample) return;
+	tNextPingSample = tNow + C4ControlPingSampleInterval;
+	// smoothed ping and mean deviation (as in TCP round trip time estimation)
+	if (!iPingSampleCnt)
+	{
+		iAvgPing = iPing * 8;
+		iPingJitter = iPing * 4;
+	}
+	else
+	{
+		int32_t iDiff = iPing * 8 - iAvgPing;
+		iAvgPing += iDiff / 8;
+		iPingJitter += (Abs(iDiff) - iPingJitter) / 4;
+	}
+	// remember sample
+	iPingSamples[iPingSampleCnt++ % C4ControlPingSamples] = iPing;
+}
+
+int32_t C4GameControlClient::getPingPercentile(int32_t iPercent) const
+{
+	int32_t iCnt = std::min(iPingSampleCnt, C4ControlPingSamples);
+	if (!iCnt) return 0;
+	int32_t Sorted[C4ControlPingSamples];
+	std::copy(iPingSamples, iPingSamples + iCnt, Sorted);
+	int32_t *pNth = Sorted + std::min(iCnt * iPercent / 100, iCnt - 1);
+	std::nth_element(Sorted, pNth, Sorted + iCnt);
+	return *pNth;
+}
+
+int32_t C4GameControlClient::getLatency() const
+{
+	// cover spikes seen recently as well as the current jitter
+	return std::max(getPingPercentile(90), getAvgPing() + 2 * getPingJitter());
+}
@@ -26,9 +26,15 @@
 const int32_t C4ControlBacklog = 100, // (ctrl ticks)
               C4ClientIDAll = C4ClientIDUnknown,
               C4ControlOverflowLimit = 3, // (ctrl ticks)
-              C4MaxPreSend = 15; // (frames) - must be smaller than C4ControlBacklog!
+              C4MaxPreSend = 15, // (frames) - must be smaller than C4ControlBacklog!
+              C4ControlRingSize = 256; // (ctrl ticks) - power of two, must be larger than C4ControlBacklog + C4MaxPreSend
 
-const uint32_t C4ControlRequestInterval = 2000; // (ms)
+const uint32_t C4ControlRequestInterval = 2000, // (ms)
+               C4ControlPingSampleInterval = 1000, // (ms)
+               C4ControlMaxPacingDelay = 20; // (ms per frame)
+
+const int32_t C4ControlPingSamples = 32, // number of ping samples kept per client
+              C4ControlPreSendDecInterval = 1000; // (ms) - min time between PreSend decrements
 
 enum C4GameControlNetworkMode
 {
@@ -38,7 +44,7 @@ enum C4GameControlNetworkMode
 };
 
 // declarations
-class C4GameControlPacket; class C4GameControlClient;
+class C4GameControlPacket; class C4GameControlClient; class C4GameControlRing;
 class C4PacketControlReq; class C4ClientList;
 
 // main class
@@ -65,14 +71,22 @@ protected:
 
 	// time started to wait.
 	C4TimeMilliseconds tWaitStart;
+	uint32_t iControlWaitTime; // total time waited for control (ms)
 
 	int32_t iAvgControlSendTime;
 	int32_t iTargetFPS; // used for PreSend-colculation
+	C4TimeMilliseconds tLastPreSendDec;
+
+	// pacing: average time waited per control tick (ms * 16), host only
+	int32_t iAvgControlWait;
+	volatile uint32_t iPacingDelay; // (ms per frame)
 
 	// control send / recv status
 	volatile int32_t iControlSent, iControlReady;
 
-	// control list
+	// control by client, indexed by control tick
+	C4GameControlRing *pCtrlRings;
+	// control that didn't fit into its ring (normally empty)
 	C4GameControlPacket *pCtrlStack;
 	CStdCSec CtrlCSec;
 
@@ -99,6 +113,8 @@ public:
 	int32_t getControlPreSend() const { return iControlPreSend; }
 	void setControlPreSend(int32_t iToVal) { iControlPreSend = std::min(iToVal, C4MaxPreSend); }
 	int32_t getAvgControlSendTime() const { return iAvgControlSendTime; }
+	uint32_t getControlWaitTime() const { return iControlWaitTime; }
+	uint32_t GetPacingDelay() const { return iPacingDelay; } // extra game tick delay while waiting for control
 	void setTargetFPS(int32_t iToVal) { iTargetFPS = iToVal; }
 
 	// main thread communication
@@ -113,6 +129,7 @@ public:
 	bool ClientReady(int32_t iClientID, int32_t iTick); // by main thread
 	int32_t ClientPerfStat(int32_t iClientID); // by main thread
 	int32_t ClientNextControl(int32_t iClientID); // by main thread
+	bool GetClientLatency(int32_t iClientID, int32_t *piAvg, int32_t *piJitter, int32_t *piHigh); // by main thread
 
 	bool CtrlNeeded(int32_t iTick) const; // by main thread
 	void DoInput(const C4Control &Input); // by main thread
@@ -137,6 +154,7 @@ public:
 
 	// interfaces
 	void HandlePacket(char cStatus, const C4PacketBase *pPacket, C4Network2IOConnection *pConn);
+	void HandlePacket(char cStatus, C4PacketBase *pPacket, C4Network2IOConnection *pConn); // may take over the packet contents
 	void OnResComplete(C4Network2Res *pRes);
 
 protected:
@@ -147,7 +165,7 @@ protected:
 	void ClearClients(); // by main thread
 
 	// packet handling
-	void HandleControl(int32_t iByClientID, const C4GameControlPacket &rPkt);
+	void HandleControl(int32_t iByClientID, C4GameControlPacket &rPkt);
 	void HandleControlReq(const C4PacketControlReq &rPkt, C4Network2IOConnection *pConn);
 	void HandleControlPkt(C4PacketType eCtrlType, C4ControlPacket *pPkt, enum C4ControlDeliveryType eType);
 
@@ -158,13 +176,14 @@ protected:
 
 	// control stack
 	C4GameControlPacket *getCtrl(int32_t iClientID, int32_t iCtrlTick); // by both
-	void AddCtrl(C4GameControlPacket *pCtrl);
+	C4GameControlRing *getCtrlRing(int32_t iClientID, bool fCreate = false); // by both
+	bool AddCtrl(C4GameControlPacket *pCtrl); // by both - fails if control is already present
 	void ClearCtrl(int32_t iBeforeTick = -1);
 	void CheckCompleteCtrl(bool fSetEvent); // by both
 	C4GameControlPacket *PackCompleteCtrl(int32_t iTick); // by main thread
 
 	// sync control
-	void AddSyncCtrlToQueue(const C4Control &Ctrl, int32_t iTick); // by main thread
+	void AddSyncCtrlToQueue(C4Control &Ctrl, int32_t iTick); // by main thread - takes over control
 	void ExecQueuedSyncCtrl(); // by main thread
 
 };
@@ -198,11 +217,38 @@ public:
 
 	void Set(int32_t iClientID, int32_t iCtrlTick);
 	void Set(int32_t iClientID, int32_t iCtrlTick, const C4Control &Ctrl);
+	void Take(int32_t iClientID, int32_t iCtrlTick, C4Control &Ctrl); // takes over packets of Ctrl
 	void Add(const C4GameControlPacket &Ctrl);
 
 	virtual void CompileFunc(StdCompiler *pComp);
 };
 
+// control of one client, stored by control tick
+class C4GameControlRing
+{
+	friend class C4GameControlNetwork;
+public:
+	C4GameControlRing(int32_t iClientID);
+	~C4GameControlRing();
+
+protected:
+	int32_t iClientID;
+	C4GameControlPacket *pSlots[C4ControlRingSize];
+
+	// list (C4GameControlNetwork)
+	C4GameControlRing *pNext;
+
+public:
+	int32_t getClientID() const { return iClientID; }
+	C4GameControlPacket *getCtrl(int32_t iCtrlTick) const;
+
+	bool Add(C4GameControlPacket *pCtrl); // fails if the slot is in use
+	void Clear(int32_t iBeforeTick = -1);
+
+private:
+	static int32_t getSlot(int32_t iCtrlTick) { return iCtrlTick & (C4ControlRingSize - 1); }
+};
+
 class C4GameControlClient
 {
 	friend class C4GameControlNetwork;
@@ -220,6 +266,11 @@ protected:
 	// performance data
 	int32_t iPerformance;
 
+	// latency model: smoothed ping and jitter (ms * 8), recent ping samples
+	int32_t iAvgPing, iPingJitter;
+	int32_t iPingSamples[C4ControlPingSamples], iPingSampleCnt;
+	C4TimeMilliseconds tNextPingSample;
+
 	// list (C4GameControl)
 	C4GameControlClient *pNext;
 
@@ -232,6 +283,13 @@ public:
 	void Set(int32_t iClientID, const char *szName);
 	void SetNextControl(int32_t inNextControl) { iNextControl = inNextControl; }
 	void AddPerf(int32_t iTime);
+
+	void AddPing(int32_t iPing);
+	bool HasPing() const { return iPingSampleCnt > 0; }
+	int32_t getAvgPing() const { return iAvgPing / 8; }
+	int32_t getPingJitter() const { return iPingJitter / 8; }
+	int32_t getPingPercentile(int32_t iPercent) const;
+	int32_t getLatency() const; // estimated round trip time the control must be sent ahead for
 };
 
 // * Packet classes *
@@ -0,0 +1,507 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2001-2009, RedWolf Design GmbH, http://www.clonk.de/
+ * Copyright (c) 2009-2013, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+#include "C4Include.h"
+#include "C4HTTPClient.h"
+
+#include "C4Version.h"
+
+#include <thread>
+#include <zlib.h>
+
+// *** C4HTTPClient
+
+// result of a host name resolution, shared with the resolving thread
+struct C4HTTPClient::ResolveData
+{
+	StdCopyStrBuf Host;
+	in_addr Addr;
+	bool fSuccess, fDone;
+	C4HTTPClient *pClient; // woken up when done; NULL once the client lost interest
+	CStdCSec CSec;
+	ResolveData() : fSuccess(false), fDone(false), pClient(NULL) { }
+};
+
+C4HTTPClient::C4HTTPClient()
+		: fResolved(false), fBinary(false), fBusy(false), fSuccess(false), fConnected(false),
+		fConnectPending(false), fKeepAlive(false), fReusedConn(false),
+		iDataOffset(0), iDownloadedSize(0), iTotalSize(0)
+{
+	C4NetIOTCP::SetCallback(this);
+}
+
+C4HTTPClient::~C4HTTPClient()
+{
+	DetachResolve();
+}
+
+void C4HTTPClient::PackPacket(const C4NetIOPacket &rPacket, StdBuf &rOutBuf)
+{
+	// Just append the packet
+	rOutBuf.Append(rPacket);
+}
+
+size_t C4HTTPClient::UnpackPacket(const StdBuf &rInBuf, const C4NetIO::addr_t &addr)
+{
+	// nothing requested? (kept-alive connection)
+	if (!fBusy)
+		return rInBuf.getSize();
+	// since new data arrived, increase timeout time
+	ResetRequestTimeout();
+	// Check for complete header
+	if (!iDataOffset)
+	{
+		// Copy data into string buffer (terminate)
+		StdStrBuf Data; Data.Copy(getBufPtr<char>(rInBuf), rInBuf.getSize());
+		const char *pData = Data.getData();
+		// Header complete?
+		const char *pContent = SSearch(pData, "\r\n\r\n");
+		if (!pContent)
+			return 0;
+		// Read the header
+		if (!ReadHeader(Data))
+		{
+			fBusy = fSuccess = false;
+			Close(addr);
+			return rInBuf.getSize();
+		}
+	}
+	iDownloadedSize = rInBuf.getSize() - iDataOffset;
+	// Check if the packet is complete
+	if (iTotalSize > iDownloadedSize)
+	{
+		return 0;
+	}
+	// Get data, uncompress it if needed
+	StdBuf Data = rInBuf.getPart(iDataOffset, iTotalSize);
+	if (fCompressed)
+		if (!Decompress(&Data))
+		{
+			fBusy = fSuccess = false;
+			Close(addr);
+			return rInBuf.getSize();
+		}
+	// Save the result
+	if (fBinary)
+		ResultBin.Copy(Data);
+	else
+		ResultString.Copy(getBufPtr<char>(Data), Data.getSize());
+	fBusy = false; fSuccess = true;
+	// Callback
+	OnPacket(C4NetIOPacket(Data, addr), this);
+	// Done. Keep the connection for the next request if the server allows it
+	if (fKeepAlive)
+	{
+		size_t iSize = iDataOffset + iTotalSize;
+		iDataOffset = 0;
+		return iSize;
+	}
+	Close(addr);
+	return rInBuf.getSize();
+}
+
+bool C4HTTPClient::ReadHeader(StdStrBuf Data)
+{
+	const char *pData = Data.getData();
+	const char *pContent = SSearch(pData, "\r\n\r\n");
+	if (!pContent)
+		return 0;
+	// Parse header line
+	int iHTTPVer1, iHTTPVer2, iResponseCode, iStatusStringPtr;
+	if (sscanf(pData, "HTTP/%d.%d %d %n", &iHTTPVer1, &iHTTPVer2, &iResponseCode, &iStatusStringPtr) != 3)
+	{
+		Error = "Invalid status line!";
+		return false;
+	}
+	// Check HTTP version
+	if (iHTTPVer1 != 1)
+	{
+		Error.Format("Unsupported HTTP version: %d.%d!", iHTTPVer1, iHTTPVer2);
+		return false;
+	}
+	// Check code
+	if (iResponseCode != 200)
+	{
+		// Get status string
+		StdStrBuf StatusString; StatusString.CopyUntil(pData + iStatusStringPtr, '\r');
+		// Create error message
+		Error.Format("HTTP server responded %d: %s", iResponseCode, StatusString.getData());
+		return false;
+	}
+	// Get content length
+	const char *pContentLength = SSearch(pData, "\r\nContent-Length:");
+	int iContentLength;
+	if (!pContentLength || pContentLength > pContent ||
+	    sscanf(pContentLength, "%d", &iContentLength) != 1)
+	{
+		Error.Format("Invalid server response: Content-Length is missing!");
+		return false;
+	}
+	iTotalSize = iContentLength;
+	iDataOffset = (pContent - pData);
+	// Get content encoding
+	const char *pContentEncoding = SSearch(pData, "\r\nContent-Encoding:");
+	if (pContentEncoding)
+	{
+		while (*pContentEncoding == ' ') pContentEncoding++;
+		StdStrBuf Encoding; Encoding.CopyUntil(pContentEncoding, '\r');
+		if (Encoding == "gzip")
+			fCompressed = true;
+		else
+			fCompressed = false;
+	}
+	else
+		fCompressed = false;
+	// Connection kept open?
+	const char *pConnection = SSearchNoCase(pData, "\r\nConnection:");
+	if (pConnection && pConnection < pContent)
+	{
+		while (*pConnection == ' ') pConnection++;
+		fKeepAlive = SEqualNoCase(pConnection, "keep-alive", 10);
+	}
+	else
+		fKeepAlive = false;
+	// Okay
+	return true;
+}
+
+bool C4HTTPClient::Decompress(StdBuf *pData)
+{
+	size_t iSize = pData->getSize();
+	// Create buffer
+	uint32_t iOutSize = *getBufPtr<uint32_t>(*pData, pData->getSize() - sizeof(uint32_t));
+	iOutSize = std::min<uint32_t>(iOutSize, iSize * 1000);
+	StdBuf Out; Out.New(iOutSize);
+	// Prepare stream
+	z_stream zstrm;
+	ZeroMem(&zstrm, sizeof(zstrm));
+	zstrm.next_in = const_cast<Byte *>(getBufPtr<Byte>(*pData));
+	zstrm.avail_in = pData->getSize();
+	zstrm.next_out = getMBufPtr<Byte>(Out);
+	zstrm.avail_out = Out.getSize();
+	// Inflate...
+	if (inflateInit2(&zstrm, 15 + 16) != Z_OK)
+	{
+		Error.Format("Could not decompress data!");
+		return false;
+	}
+	// Inflate!
+	if (inflate(&zstrm, Z_FINISH) != Z_STREAM_END)
+	{
+		inflateEnd(&zstrm);
+		Error.Format("Could not decompress data!");
+		return false;
+	}
+	// Return the buffer
+	Out.SetSize(zstrm.total_out);
+	pData->Take(std::move(Out));
+	// Okay
+	inflateEnd(&zstrm);
+	return true;
+}
+
+bool C4HTTPClient::OnConn(const C4NetIO::addr_t &AddrPeer, const C4NetIO::addr_t &AddrConnect, const C4NetIO::addr_t *pOwnAddr, C4NetIO *pNetIO)
+{
+	// Make sure we're actually waiting for this connection
+	if (!AddrEqual(AddrConnect, ServerAddr))
+		return false;
+	// Save pack peer address
+	PeerAddr = AddrPeer;
+	// Send the request
+	Send(C4NetIOPacket(Request, AddrPeer));
+	Request.Clear();
+	fConnected = true;
+	return true;
+}
+
+void C4HTTPClient::OnDisconn(const C4NetIO::addr_t &AddrPeer, C4NetIO *pNetIO, const char *szReason)
+{
+	fConnected = false;
+	// Response already handled, or idle kept-alive connection closed? Nothing to report
+	if (!fBusy && fSuccess)
+		return;
+	// Kept-alive connection closed before the server saw the request? Retry on a new one
+	if (fBusy && fReusedConn && !iDataOffset && !iDownloadedSize)
+	{
+		fReusedConn = false;
+		if (Connect(ServerAddr))
+			return;
+	}
+	// Got no complete packet? Failure...
+	if (!fSuccess && Error.isNull())
+	{
+		fBusy = false;
+		Error.Format("Unexpected disconnect: %s", szReason);
+	}
+	// Notify
+	OnResponse();
+}
+
+void C4HTTPClient::OnPacket(const class C4NetIOPacket &rPacket, C4NetIO *pNetIO)
+{
+	// Everything worthwhile was already done in UnpackPacket. Only do notify callback
+	OnResponse();
+}
+
+bool C4HTTPClient::Execute(int iMaxTime)
+{
+	// Check timeout
+	if (fBusy && time(NULL) > iRequestTimeout)
+	{
+		Cancel("Request timeout");
+		return true;
+	}
+	// Execute normally
+	if (!C4NetIOTCP::Execute(iMaxTime))
+		return false;
+	// Server address resolved? The resolving thread woke us up
+	if (pResolve)
+	{
+		bool fDone;
+		{ CStdLock Lock(&pResolve->CSec); fDone = pResolve->fDone; }
+		if (fDone)
+			OnResolved();
+	}
+	return true;
+}
+
+C4TimeMilliseconds C4HTTPClient::GetNextTick(C4TimeMilliseconds tNow)
+{
+	C4TimeMilliseconds tNetIOTCPTick = C4NetIOTCP::GetNextTick(tNow);
+	if (!fBusy)
+		return tNetIOTCPTick;
+
+	C4TimeMilliseconds tHTTPClientTick = tNow + 1000 * std::max<time_t>(iRequestTimeout - time(NULL), 0);
+
+	return std::max(tNetIOTCPTick, tHTTPClientTick);
+}
+
+bool C4HTTPClient::Query(const StdBuf &Data, bool fBinary)
+{
+	if (Server.isNull()) return false;
+	// Cancel previous request
+	if (fBusy)
+		Cancel("Cancelled");
+	// No result known yet
+	ResultString.Clear();
+	iDownloadedSize = iTotalSize = iDataOffset = 0;
+	fSuccess = fKeepAlive = fReusedConn = false;
+	// store mode
+	this->fBinary = fBinary;
+	// Create request
+	StdStrBuf Header;
+	if (Data.getSize())
+		Header.Format(
+		  "POST %s HTTP/1.0\r\n"
+		  "Host: %s\r\n"
+		  "Connection: Keep-Alive\r\n"
+		  "Content-Length: %lu\r\n"
+		  "Content-Type: text/plain; charset=utf-8\r\n"
+		  "Accept-Charset: utf-8\r\n"
+		  "Accept-Encoding: gzip\r\n"
+		  "Accept-Language: %s\r\n"
+		  "User-Agent: " C4ENGINENAME "/" C4VERSION "\r\n"
+		  "\r\n",
+		  RequestPath.getData(),
+		  Server.getData(),
+		  static_cast<unsigned long>(Data.getSize()),
+		  GetLanguage());
+	else
+		Header.Format(
+		  "GET %s HTTP/1.0\r\n"
+		  "Host: %s\r\n"
+		  "Connection: Keep-Alive\r\n"
+		  "Accept-Charset: utf-8\r\n"
+		  "Accept-Encoding: gzip\r\n"
+		  "Accept-Language: %s\r\n"
+		  "User-Agent: " C4ENGINENAME "/" C4VERSION "\r\n"
+		  "\r\n",
+		  RequestPath.getData(),
+		  Server.getData(),
+		  GetLanguage());
+	// Compose query
+	Request.Take(Header.GrabPointer(), Header.getLength());
+	Request.Append(Data);
+	// Connection to the server still open? Send right away
+	if (fConnected && Send(C4NetIOPacket(Request, PeerAddr)))
+		fReusedConn = true;
+	// Address known? Start connecting
+	else if (fResolved)
+	{
+		if (!Connect(ServerAddr))
+			return false;
+	}
+	// Still resolving? Connect when done
+	else if (pResolve)
+		fConnectPending = true;
+	else
+	{
+		SetError(FormatString("Could not resolve server address %s!", Server.getData()).getData());
+		return false;
+	}
+	// Okay, request will be performed when connection is complete
+	fBusy = true;
+	ResetRequestTimeout();
+	ResetError();
+	return true;
+}
+
+void C4HTTPClient::ResetRequestTimeout()
+{
+	// timeout C4HTTPQueryTimeout seconds from this point
+	iRequestTimeout = time(NULL) + C4HTTPQueryTimeout;
+}
+
+void C4HTTPClient::Cancel(const char *szReason)
+{
+	// Close connection - and connection attempt
+	Close(ServerAddr); Close(PeerAddr);
+	// Reset flags
+	fBusy = fSuccess = fConnected = fBinary = fConnectPending = false;
+	iDownloadedSize = iTotalSize = iDataOffset = 0;
+	Error = szReason;
+}
+
+void C4HTTPClient::Clear()
+{
+	fBusy = fSuccess = fConnected = fBinary = false;
+	iDownloadedSize = iTotalSize = iDataOffset = 0;
+	ResultBin.Clear();
+	ResultString.Clear();
+	Error.Clear();
+}
+
+bool C4HTTPClient::SetServer(const char *szServerAddress)
+{
+	// Split address
+	StdCopyStrBuf Address;
+	const char *pRequestPath;
+	if ((pRequestPath = strchr(szServerAddress, '/')))
+	{
+		Address.CopyUntil(szServerAddress, '/');
+		RequestPath = pRequestPath;
+	}
+	else
+	{
+		Address = szServerAddress;
+		RequestPath = "/";
+	}
+	// Same server? Keep address and connection
+	ResetError();
+	if (Address == ServerAddress && (fResolved || pResolve))
+		return true;
+	// Drop connection to the old server
+	if (fConnected && !fBusy)
+		{ Close(PeerAddr); fConnected = false; }
+	ServerAddress = Address;
+	DetachResolve(); fResolved = false;
+	// Remove port
+	Server = Address;
+	int32_t iPort = GetDefaultPort();
+	const char *pColon = strchr(Server.getData(), ':');
+	if (pColon)
+	{
+		iPort = atoi(pColon + 1);
+		Server.SetLength(pColon - Server.getData());
+	}
+	ZeroMem(&ServerAddr, sizeof ServerAddr);
+	ServerAddr.sin_family = AF_INET;
+	ServerAddr.sin_port = htons(iPort);
+	// Plain IP address?
+	if ((ServerAddr.sin_addr.s_addr = inet_addr(Server.getData())) != INADDR_NONE)
+	{
+		fResolved = true;
+		return true;
+	}
+	// Resolve host name on its own thread. The client might be gone
+	// by the time it is done, so the result is shared with the thread
+	std::shared_ptr<ResolveData> pData = std::make_shared<ResolveData>();
+	pData->Host.Copy(Server);
+	if (fInit) pData->pClient = this;
+	std::thread([pData]()
+	{
+		in_addr Addr = in_addr();
+		bool fSuccess = false;
+#ifdef HAVE_WINSOCK
+		// the client might release WinSock before we are done
+		if (AcquireWinSock())
+		{
+			fSuccess = ResolveHostName(pData->Host.getData(), &Addr);
+			ReleaseWinSock();
+		}
+#else
+		fSuccess = ResolveHostName(pData->Host.getData(), &Addr);
+#endif
+		CStdLock Lock(&pData->CSec);
+		pData->Addr = Addr;
+		pData->fSuccess = fSuccess;
+		pData->fDone = true;
+		// wake the client up so that it picks up the result
+		if (pData->pClient)
+			pData->pClient->UnBlock();
+	}).detach();
+	pResolve = pData;
+	return true;
+}
+
+void C4HTTPClient::DetachResolve()
+{
+	if (!pResolve) return;
+	// the thread must not wake us up anymore
+	{ CStdLock Lock(&pResolve->CSec); pResolve->pClient = NULL; }
+	pResolve.reset();
+}
+
+bool C4HTTPClient::Close()
+{
+	// the thread would wake up a closed client
+	DetachResolve();
+	return C4NetIOTCP::Close();
+}
+
+void C4HTTPClient::OnResolved()
+{
+	// Take result
+	std::shared_ptr<ResolveData> pData = pResolve;
+	DetachResolve();
+	if (!pData->fSuccess)
+	{
+		StdStrBuf Reason = FormatString("Could not resolve server address %s!", Server.getData());
+		if (fConnectPending)
+			FailRequest(Reason.getData());
+		else
+			SetError(Reason.getData());
+		return;
+	}
+	ServerAddr.sin_addr = pData->Addr;
+	fResolved = true;
+	// Request waiting? Start connecting
+	if (fConnectPending)
+	{
+		fConnectPending = false;
+		if (!Connect(ServerAddr))
+			FailRequest(GetError());
+	}
+}
+
+void C4HTTPClient::FailRequest(const char *szReason)
+{
+	// Fail the running request and tell whoever waits for it
+	StdCopyStrBuf Reason(szReason);
+	fBusy = fSuccess = fConnectPending = false;
+	Error = Reason;
+	OnResponse();
+}
+
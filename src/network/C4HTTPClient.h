@@ -0,0 +1,113 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2001-2009, RedWolf Design GmbH, http://www.clonk.de/
+ * Copyright (c) 2009-2013, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+/* mini HTTP client on top of C4NetIOTCP */
+
+#ifndef C4HTTPCLIENT_H
+#define C4HTTPCLIENT_H
+
+#include "C4NetIO.h"
+
+const int C4HTTPQueryTimeout = 10; // (s)
+
+// One request at a time; the connection is kept open for the next one if the server allows it.
+// Host names are resolved on their own thread, which wakes the client up when it is done.
+class C4HTTPClient : public C4NetIOTCP, private C4NetIO::CBClass
+{
+public:
+	C4HTTPClient();
+	virtual ~C4HTTPClient();
+
+private:
+
+	// Address information
+	C4NetIO::addr_t ServerAddr, PeerAddr;
+	StdCopyStrBuf ServerAddress, Server, RequestPath;
+
+	// Host name resolution, shared with the resolving thread
+	struct ResolveData;
+	std::shared_ptr<ResolveData> pResolve;
+	bool fResolved;
+
+	bool fBinary;
+	bool fBusy, fSuccess, fConnected;
+	bool fConnectPending; // connect as soon as the server address is resolved
+	bool fKeepAlive; // server keeps the connection open for the next request
+	bool fReusedConn; // request was sent over a kept-alive connection
+	size_t iDataOffset;
+	StdCopyBuf Request;
+	time_t iRequestTimeout;
+
+	// Response header data
+	size_t iDownloadedSize, iTotalSize;
+	bool fCompressed;
+
+protected:
+	StdCopyBuf ResultBin; // set if fBinary
+	StdCopyStrBuf ResultString; // set if !fBinary
+
+protected:
+
+	// Overridden
+	virtual void PackPacket(const C4NetIOPacket &rPacket, StdBuf &rOutBuf);
+	virtual size_t UnpackPacket(const StdBuf &rInBuf, const C4NetIO::addr_t &addr);
+
+	// Callbacks
+	bool OnConn(const C4NetIO::addr_t &AddrPeer, const C4NetIO::addr_t &AddrConnect, const addr_t *pOwnAddr, C4NetIO *pNetIO);
+	void OnDisconn(const C4NetIO::addr_t &AddrPeer, C4NetIO *pNetIO, const char *szReason);
+	void OnPacket(const class C4NetIOPacket &rPacket, C4NetIO *pNetIO);
+
+	void ResetRequestTimeout();
+	void OnResolved();
+	void DetachResolve();
+	void FailRequest(const char *szReason);
+	virtual int32_t GetDefaultPort() { return 80; }
+	virtual const char *GetLanguage() { return "en"; }
+	virtual void OnResponse() { } // request done or failed
+
+public:
+	bool Query(const StdBuf &Data, bool fBinary);
+	bool Query(const char *szData, bool fBinary) { return Query(StdBuf(szData, SLen(szData)), fBinary); }
+
+	bool isBusy() const { return fBusy; }
+	bool isSuccess() const { return fSuccess; }
+	bool isConnected() const { return fConnected; }
+	size_t getTotalSize() const { return iTotalSize; }
+	size_t getDownloadedSize() const { return iDownloadedSize; }
+	const StdBuf &getResultBin() const { assert(fBinary); return ResultBin; }
+	const char *getResultString() const { assert(!fBinary); return ResultString.getData(); }
+	const char *getServerName() const { return Server.getData(); }
+	const char *getRequest() const { return RequestPath.getData(); }
+	const C4NetIO::addr_t &getServerAddress() const { return ServerAddr; }
+
+	void Cancel(const char *szReason);
+	void Clear();
+
+	bool SetServer(const char *szServerAddress);
+
+	// Overridden
+	using C4NetIOTCP::Close;
+	virtual bool Close();
+	virtual bool Execute(int iMaxTime, pollfd * readyfds) { return Execute(iMaxTime); }
+	virtual bool Execute(int iMaxTime = TO_INF);
+	virtual C4TimeMilliseconds GetNextTick(C4TimeMilliseconds tNow);
+
+private:
+	bool ReadHeader(StdStrBuf Data);
+	bool Decompress(StdBuf *pData);
+
+};
+
+#endif // C4HTTPCLIENT_H
@@ -145,9 +145,11 @@ void ResetSocketError()
 }
 
 static int iWSockUseCounter = 0;
+static CStdCSec WSockCSec; // host name resolution acquires WinSock on its own thread
 
 bool AcquireWinSock()
 {
+	CStdLock Lock(&WSockCSec);
 	if (!iWSockUseCounter)
 	{
 		// initialize winsock
@@ -166,6 +168,7 @@ bool AcquireWinSock()
 
 void ReleaseWinSock()
 {
+	CStdLock Lock(&WSockCSec);
 	iWSockUseCounter--;
 	// last use?
 	if (!iWSockUseCounter)
@@ -243,6 +246,16 @@ C4NetIOPacket::C4NetIOPacket(const StdBuf &Buf, const C4NetIO::addr_t &naddr)
 {
 }
 
+C4NetIOPacket::C4NetIOPacket(StdBuf &&Buf, const C4NetIO::addr_t &naddr)
+		: StdCopyBuf(std::move(Buf)), addr(naddr)
+{
+}
+
+C4NetIOPacket::C4NetIOPacket(C4NetIOPacket &&rPacket) noexcept
+		: StdCopyBuf(std::move(rPacket)), addr(rPacket.addr)
+{
+}
+
 C4NetIOPacket::C4NetIOPacket(uint8_t cStatusByte, const char *pnData, size_t inSize, const C4NetIO::addr_t &naddr)
 {
 	// Create buffer
@@ -820,7 +833,7 @@ bool C4NetIOTCP::GetStatistic(int *pBroadcastRate) // (mt-safe)
 	return true;
 }
 
-bool C4NetIOTCP::GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss) // (mt-safe)
+bool C4NetIOTCP::GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss, int *pResent) // (mt-safe)
 {
 	CStdShareLock PeerListLock(&PeerListCSec);
 	// find peer
@@ -830,6 +843,7 @@ bool C4NetIOTCP::GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate,
 	if (pIRate) *pIRate = pPeer->GetIRate();
 	if (pORate) *pORate = pPeer->GetORate();
 	if (pLoss) *pLoss = 0;
+	if (pResent) *pResent = 0;
 	return true;
 }
 
@@ -1302,12 +1316,20 @@ void C4NetIOTCP::Peer::ClearStatistics() // (mt-safe)
 
 // *** C4NetIOSimpleUDP
 
+#ifdef HAVE_RECVMMSG
+const unsigned int C4NetIOSimpleUDP::iRecvBatchSize = 8;
+const size_t C4NetIOSimpleUDP::iRecvBatchMsgSize = 65536;
+#endif
+
 C4NetIOSimpleUDP::C4NetIOSimpleUDP()
 		: fInit(false), fMultiCast(false), iPort(~0), sock(INVALID_SOCKET),
 #ifdef STDSCHEDULER_USE_EVENTS
 		hEvent(NULL),
 #endif
 		fAllowReUse(false)
+#ifdef HAVE_RECVMMSG
+		, fInRecvBatch(false)
+#endif
 {
 
 }
@@ -1536,6 +1558,12 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime, pollfd *)
 	if (eWR == WR_Cancelled || eWR == WR_Timeout) return true;
 	assert(eWR == WR_Readable);
 
+#ifdef HAVE_RECVMMSG
+	// read many packets at once (not while a callback is still using the buffer)
+	if (!fInRecvBatch)
+		return ReceiveBatched();
+#endif
+
 	// read packets from socket
 	for (;;)
 	{
@@ -1619,6 +1647,114 @@ bool C4NetIOSimpleUDP::Send(const C4NetIOPacket &rPacket)
 	return true;
 }
 
+bool C4NetIOSimpleUDP::SendBatch(const C4NetIOPacket *pPackets, size_t iPacketCnt)
+{
+	if (!fInit) { SetError("not yet initialized"); return false; }
+
+#ifdef HAVE_SENDMMSG
+	const size_t iMaxBatchSize = 64;
+	mmsghdr Msgs[iMaxBatchSize]; iovec IOVecs[iMaxBatchSize]; addr_t Addrs[iMaxBatchSize];
+	while (iPacketCnt)
+	{
+		// set up message headers
+		size_t iBatchSize = std::min(iPacketCnt, iMaxBatchSize);
+		memset(Msgs, 0, sizeof(mmsghdr) * iBatchSize);
+		for (size_t i = 0; i < iBatchSize; i++)
+		{
+			Addrs[i] = pPackets[i].getAddr();
+			IOVecs[i].iov_base = const_cast<void *>(pPackets[i].getData());
+			IOVecs[i].iov_len = pPackets[i].getSize();
+			Msgs[i].msg_hdr.msg_name = &Addrs[i];
+			Msgs[i].msg_hdr.msg_namelen = sizeof(addr_t);
+			Msgs[i].msg_hdr.msg_iov = &IOVecs[i];
+			Msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+		// send
+		int iSent = ::sendmmsg(sock, Msgs, iBatchSize, 0);
+		if (iSent == SOCKET_ERROR)
+		{
+			// like sendto: drop the packet if the buffer is full
+			if (!HaveWouldBlockError())
+			{
+				SetError("socket sendmmsg failed", true);
+				return false;
+			}
+			iSent = 1;
+		}
+		pPackets += iSent; iPacketCnt -= iSent;
+	}
+	ResetError();
+	return true;
+#else
+	bool fSuccess = true;
+	for (size_t i = 0; i < iPacketCnt; i++)
+		fSuccess &= C4NetIOSimpleUDP::Send(pPackets[i]);
+	return fSuccess;
+#endif
+}
+
+#ifdef HAVE_RECVMMSG
+bool C4NetIOSimpleUDP::ReceiveBatched()
+{
+	// (lazy) allocate receive buffer
+	if (RecvBatchBuf.getSize() != iRecvBatchSize * iRecvBatchMsgSize)
+		RecvBatchBuf.New(iRecvBatchSize * iRecvBatchMsgSize);
+	fInRecvBatch = true;
+	bool fSuccess = true;
+	mmsghdr Msgs[iRecvBatchSize]; iovec IOVecs[iRecvBatchSize]; addr_t SrcAddrs[iRecvBatchSize];
+	for (;;)
+	{
+		// set up message headers
+		memset(Msgs, 0, sizeof(Msgs)); memset(SrcAddrs, 0, sizeof(SrcAddrs));
+		for (unsigned int i = 0; i < iRecvBatchSize; i++)
+		{
+			IOVecs[i].iov_base = getMBufPtr<char>(RecvBatchBuf, i * iRecvBatchMsgSize);
+			IOVecs[i].iov_len = iRecvBatchMsgSize;
+			Msgs[i].msg_hdr.msg_name = &SrcAddrs[i];
+			Msgs[i].msg_hdr.msg_namelen = sizeof(addr_t);
+			Msgs[i].msg_hdr.msg_iov = &IOVecs[i];
+			Msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+		// read what's there
+		int iMsgCnt = ::recvmmsg(sock, Msgs, iRecvBatchSize, MSG_DONTWAIT, NULL);
+		if (iMsgCnt == SOCKET_ERROR)
+		{
+			// nothing left to read?
+			if (HaveWouldBlockError())
+				break;
+			if (HaveConnResetError())
+			{
+				// notification (see Execute)
+				if (pCB) pCB->OnDisconn(SrcAddrs[0], this, GetSocketErrorMsg());
+				continue;
+			}
+			SetError("could not receive data from socket", true);
+			fSuccess = false;
+			break;
+		}
+		// pass packets on (as references to the receive buffer)
+		for (int i = 0; i < iMsgCnt; i++)
+		{
+			// invalid address?
+			if (Msgs[i].msg_hdr.msg_namelen != sizeof(addr_t) || SrcAddrs[i].sin_family != AF_INET)
+			{
+				SetError("recvmmsg returned an invalid address");
+				fSuccess = false;
+				break;
+			}
+			if (!Msgs[i].msg_len) continue;
+			C4NetIOPacket Pkt(getBufPtr<char>(RecvBatchBuf, i * iRecvBatchMsgSize), Msgs[i].msg_len, false, SrcAddrs[i]);
+			if (pCB) pCB->OnPacket(Pkt, this);
+		}
+		// buffer not filled? Then the socket has been drained.
+		if (!fSuccess || iMsgCnt < int(iRecvBatchSize))
+			break;
+	}
+	fInRecvBatch = false;
+	return fSuccess;
+}
+#endif
+
 bool C4NetIOSimpleUDP::Broadcast(const C4NetIOPacket &rPacket)
 {
 	// just set broadcast address and send
@@ -1734,7 +1870,7 @@ void C4NetIOSimpleUDP::SetReUseAddress(bool fAllow)
 #define C4NETIOUDP_OPT_RECV_CHECK_IMMEDIATE
 
 // Protocol version
-const unsigned int C4NetIOUDP::iVersion = 2;
+const unsigned int C4NetIOUDP::iVersion = 3;
 
 // Standard timeout length
 const unsigned int C4NetIOUDP::iStdTimeout = 1000; // (ms)
@@ -2082,6 +2218,7 @@ bool C4NetIOUDP::Broadcast(const C4NetIOPacket &rPacket) // (mt-safe)
 		if (pPeer->Open() && pPeer->MultiCast() && pPeer->doBroadcast())
 			break;
 	bool fSuccess = true;
+	SendBatch Batch;
 	if (pPeer)
 	{
 		CStdLock OutLock(&OutCSec);
@@ -2091,12 +2228,14 @@ bool C4NetIOUDP::Broadcast(const C4NetIOPacket &rPacket) // (mt-safe)
 		// add to list
 		OPackets.AddPacket(pPkt);
 		// send it
-		fSuccess &= BroadcastDirect(*pPkt);
+		fSuccess &= BroadcastDirect(*pPkt, ~0u, &Batch);
 	}
 	// send to all clients connected via du, too
 	for (pPeer = pPeerList; pPeer; pPeer = pPeer->Next)
 		if (pPeer->Open() && !pPeer->MultiCast() && pPeer->doBroadcast())
-			pPeer->Send(rPacket);
+			pPeer->Send(rPacket, &Batch);
+	// one go for all peers
+	SendDirect(Batch);
 	return true;
 }
 
@@ -2133,7 +2272,7 @@ bool C4NetIOUDP::GetStatistic(int *pBroadcastRate) // (mt-safe)
 	return true;
 }
 
-bool C4NetIOUDP::GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss) // (mt-safe)
+bool C4NetIOUDP::GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss, int *pResent) // (mt-safe)
 {
 	CStdShareLock PeerListLock(&PeerListCSec);
 	// find peer
@@ -2142,7 +2281,8 @@ bool C4NetIOUDP::GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate,
 	// return statistics
 	if (pIRate) *pIRate = pPeer->GetIRate();
 	if (pORate) *pORate = pPeer->GetORate();
-	if (pLoss) *pLoss = 0;
+	if (pLoss) *pLoss = pPeer->GetLoss();
+	if (pResent) *pResent = pPeer->GetResent();
 	return true;
 }
 
@@ -2260,7 +2400,7 @@ C4NetIOUDP::Packet::Packet()
 
 C4NetIOUDP::Packet::Packet(C4NetIOPacket &&rnData, nr_t inNr)
 		: iNr(inNr),
-		Data(rnData),
+		Data(std::move(rnData)),
 		pFragmentGot(NULL)
 {
 
@@ -2273,7 +2413,7 @@ C4NetIOUDP::Packet::~Packet()
 
 // implementation
 
-const size_t C4NetIOUDP::Packet::MaxSize = 512;
+const size_t C4NetIOUDP::Packet::MaxSize = 1280; // stays below common path MTUs (incl. IP and UDP headers)
 const size_t C4NetIOUDP::Packet::MaxDataSize = MaxSize - sizeof(DataPacketHdr);
 
 C4NetIOUDP::Packet::nr_t C4NetIOUDP::Packet::FragmentCnt() const
@@ -2297,7 +2437,7 @@ C4NetIOPacket C4NetIOUDP::Packet::GetFragment(nr_t iFNr, bool fBroadcastFlag) co
 	Packet.Write(Data.getPart(iFNr * MaxDataSize, iFragmentSize),
 	             sizeof(DataPacketHdr));
 	// return
-	return C4NetIOPacket(Packet, Data.getAddr());
+	return C4NetIOPacket(std::move(Packet), Data.getAddr());
 }
 
 bool C4NetIOUDP::Packet::Complete() const
@@ -2503,7 +2643,7 @@ C4NetIOUDP::Peer::Peer(const sockaddr_in &naddr, C4NetIOUDP *pnParent)
 		iIMCPacketCounter(0), iRIMCPacketCounter(0),
 		iMCAckPacketCounter(0),
 		tNextReCheck(C4TimeMilliseconds::NegativeInfinity),
-		iIRate(0), iORate(0), iLoss(0)
+		iIRate(0), iORate(0), iLoss(0), iResent(0)
 {
 	ZeroMem(&addr2, sizeof(addr2));
 	ZeroMem(&PeerAddr, sizeof(PeerAddr));
@@ -2522,7 +2662,7 @@ bool C4NetIOUDP::Peer::Connect(bool fFailCallback) // (mt-safe)
 	return DoConn(false);
 }
 
-bool C4NetIOUDP::Peer::Send(const C4NetIOPacket &rPacket) // (mt-safe)
+bool C4NetIOUDP::Peer::Send(const C4NetIOPacket &rPacket, SendBatch *pBatch) // (mt-safe)
 {
 	CStdLock OutLock(&OutCSec);
 	// encapsulate packet
@@ -2537,7 +2677,7 @@ bool C4NetIOUDP::Peer::Send(const C4NetIOPacket &rPacket) // (mt-safe)
 	// is etablished completly.
 	if (eStatus != CS_Works) return true;
 	// send it
-	if (!SendDirect(*pnPacket)) {
+	if (!SendDirect(*pnPacket, ~0, pBatch)) {
 		Close("failed to send packet");
 		return false;
 	}
@@ -2605,7 +2745,13 @@ void C4NetIOUDP::Peer::OnRecv(const C4NetIOPacket &rPacket) // (mt-safe)
 		if (rPacket.getSize() != sizeof(ConnPacket)) break;
 		const ConnPacket *pPkt = getBufPtr<ConnPacket>(rPacket);
 		// right version?
-		if (pPkt->ProtocolVer != pParent->iVersion) break;
+		if (pPkt->ProtocolVer != pParent->iVersion)
+		{
+			// refuse instead of letting the connection time out
+			if (!fBroadcasted)
+				Close(FormatString("wrong network protocol version (%d, I have %d)", int(pPkt->ProtocolVer), int(pParent->iVersion)).getData());
+			break;
+		}
 		if (!fBroadcasted)
 		{
 			// Second connection attempt using different address?
@@ -2750,6 +2896,7 @@ void C4NetIOUDP::Peer::OnRecv(const C4NetIOPacket &rPacket) // (mt-safe)
 		// read ask list
 		const int *pAskList = getBufPtr<int>(rPacket, sizeof(CheckPacketHdr));
 		// send the packets he asks for
+		SendBatch Batch;
 		unsigned int i;
 		for (i = 0; i < pPkt->AskCount + pPkt->MCAskCount; i++)
 		{
@@ -2760,10 +2907,12 @@ void C4NetIOUDP::Peer::OnRecv(const C4NetIOPacket &rPacket) // (mt-safe)
 			if (!pPkt2Send) { Close("starvation"); break; }
 			// send the fragment
 			if (fMCPacket)
-				pParent->BroadcastDirect(*pPkt2Send, pAskList[i]);
+				pParent->BroadcastDirect(*pPkt2Send, pAskList[i], &Batch);
 			else
-				SendDirect(*pPkt2Send, pAskList[i]);
+				SendDirect(*pPkt2Send, pAskList[i], &Batch);
 		}
+		{ CStdLock StatLock(&StatCSec); iResent += i; }
+		pParent->SendDirect(Batch);
 	}
 	break;
 
@@ -2809,7 +2958,7 @@ void C4NetIOUDP::Peer::ClearStatistics()
 {
 	CStdLock StatLock(&StatCSec);
 	iIRate = iORate = 0;
-	iLoss = 0;
+	iLoss = iResent = 0;
 }
 
 bool C4NetIOUDP::Peer::DoConn(bool fMC) // (mt-safe)
@@ -2852,29 +3001,29 @@ bool C4NetIOUDP::Peer::DoCheck(int iAskCnt, int iMCAskCnt, unsigned int *pAskLis
 	if (pAskList)
 		Packet.Write(pAskList, iAskListSize, sizeof(CheckPacketHdr));
 	// send packet
-	return SendDirect(C4NetIOPacket(Packet, addr));
+	return SendDirect(C4NetIOPacket(std::move(Packet), addr));
 }
 
-bool C4NetIOUDP::Peer::SendDirect(const Packet &rPacket, unsigned int iNr)
+bool C4NetIOUDP::Peer::SendDirect(const Packet &rPacket, unsigned int iNr, SendBatch *pBatch)
 {
 	// send one fragment only?
 	if (iNr + 1)
-		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr()));
-	// otherwise: send all fragments
-	bool fSuccess = true;
+		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr()), pBatch);
+	// otherwise: send all fragments at once
+	SendBatch Batch; Batch.reserve(rPacket.FragmentCnt());
 	for (unsigned int i = 0; i < rPacket.FragmentCnt(); i++)
-		fSuccess &= SendDirect(rPacket.GetFragment(i));
-	return fSuccess;
+		SendDirect(rPacket.GetFragment(i), pBatch ? pBatch : &Batch);
+	return pBatch || pParent->SendDirect(Batch);
 }
 
-bool C4NetIOUDP::Peer::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
+bool C4NetIOUDP::Peer::SendDirect(C4NetIOPacket &&rPacket, SendBatch *pBatch) // (mt-safe)
 {
 	// insert correct addr
 	if (!(rPacket.getStatus() & 0x80)) rPacket.SetAddr(addr);
 	// count outgoing
 	{ CStdLock StatLock(&StatCSec); iORate += rPacket.getSize() + iUDPHeaderSize; }
 	// forward call
-	return pParent->SendDirect(std::move(rPacket));
+	return pParent->SendDirect(std::move(rPacket), pBatch);
 }
 
 void C4NetIOUDP::Peer::OnConn()
@@ -2984,19 +3133,25 @@ void C4NetIOUDP::Peer::OnTimeout()
 
 // * C4NetIOUDP: implementation
 
-bool C4NetIOUDP::BroadcastDirect(const Packet &rPacket, unsigned int iNr) // (mt-safe)
+bool C4NetIOUDP::BroadcastDirect(const Packet &rPacket, unsigned int iNr, SendBatch *pBatch) // (mt-safe)
 {
 	// only one fragment?
 	if (iNr + 1)
-		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr(), true));
-	// send all fragments
-	bool fSuccess = true;
+		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr(), true), pBatch);
+	// send all fragments at once
+	SendBatch Batch; Batch.reserve(rPacket.FragmentCnt());
 	for (unsigned int iFrgm = 0; iFrgm < rPacket.FragmentCnt(); iFrgm++)
-		fSuccess &= SendDirect(rPacket.GetFragment(iFrgm, true));
-	return fSuccess;
+		SendDirect(rPacket.GetFragment(iFrgm, true), pBatch ? pBatch : &Batch);
+	return pBatch || SendDirect(Batch);
 }
 
-bool C4NetIOUDP::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
+bool C4NetIOUDP::SendDirect(SendBatch &Batch) // (mt-safe)
+{
+	if (Batch.empty()) return true;
+	return C4NetIOSimpleUDP::SendBatch(&Batch[0], Batch.size());
+}
+
+bool C4NetIOUDP::SendDirect(C4NetIOPacket &&rPacket, SendBatch *pBatch) // (mt-safe)
 {
 	addr_t toaddr = rPacket.getAddr();
 	// packet meant to be broadcasted?
@@ -3019,6 +3174,16 @@ bool C4NetIOUDP::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
 		if (SafeRandom(100) < C4NETIO_SIMULATE_PACKETLOSS) return true;
 #endif
 
+	// collect it?
+	if (pBatch)
+	{
+		// (batched packets are sent later, so they must hold their own data)
+		assert(!rPacket.isRef());
+		rPacket.SetAddr(toaddr);
+		pBatch->push_back(std::move(rPacket));
+		return true;
+	}
+
 	// send it
 	return C4NetIOSimpleUDP::Send(C4NetIOPacket(rPacket.getRef(), toaddr));
 }
@@ -3364,6 +3529,21 @@ void C4NetIOMan::EnlargeIO(int iBy)
 
 // *** helpers
 
+bool ResolveHostName(const char *szHost, in_addr *pAddr) // (mt-safe)
+{
+	assert(szHost && pAddr);
+	// getaddrinfo is thread-safe, unlike gethostbyname
+	addrinfo Hints; ZeroMem(&Hints, sizeof Hints);
+	Hints.ai_family = AF_INET;
+	Hints.ai_socktype = SOCK_STREAM;
+	addrinfo *pResult = NULL;
+	if (getaddrinfo(szHost, NULL, &Hints, &pResult) || !pResult)
+		return false;
+	*pAddr = reinterpret_cast<sockaddr_in *>(pResult->ai_addr)->sin_addr;
+	freeaddrinfo(pResult);
+	return true;
+}
+
 bool ResolveAddress(const char *szAddress, C4NetIO::addr_t *paddr, uint16_t iPort)
 {
 	assert(szAddress && paddr);
@@ -3389,19 +3569,12 @@ bool ResolveAddress(const char *szAddress, C4NetIO::addr_t *paddr, uint16_t iPor
 		if (!AcquireWinSock()) return false;
 #endif
 		// resolve
-		hostent *pHost;
-		if (!(pHost = gethostbyname(szAddress)))
+		bool fResolved = ResolveHostName(szAddress, &raddr.sin_addr);
 #ifdef HAVE_WINSOCK
-			{ ReleaseWinSock(); return false; }
 		ReleaseWinSock();
-#else
-			return false;
 #endif
-		// correct type?
-		if (pHost->h_addrtype != AF_INET || pHost->h_length != sizeof(in_addr))
+		if (!fResolved)
 			return false;
-		// get address
-		raddr.sin_addr = *reinterpret_cast<in_addr *>(pHost->h_addr_list[0]);
 	}
 	// ok
 	*paddr = raddr;
@@ -126,7 +126,7 @@ public:
 
 	// statistics
 	virtual bool GetStatistic(int *pBroadcastRate) = 0;
-	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss) = 0;
+	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss, int *pResent) = 0;
 	virtual void ClearStatistic() = 0;
 
 	// *** errors
@@ -153,9 +153,15 @@ public:
 	C4NetIOPacket(const void *pnData, size_t inSize, bool fCopy = false, const C4NetIO::addr_t &naddr = C4NetIO::addr_t());
 	// construct from buffer (copies data)
 	explicit C4NetIOPacket(const StdBuf &Buf, const C4NetIO::addr_t &naddr);
+	// construct from temporary buffer (takes over / references data)
+	C4NetIOPacket(StdBuf &&Buf, const C4NetIO::addr_t &naddr);
 	// construct from status byte + buffer (copies data)
 	C4NetIOPacket(uint8_t cStatusByte, const char *pnData, size_t inSize, const C4NetIO::addr_t &naddr = C4NetIO::addr_t());
 
+	C4NetIOPacket(const C4NetIOPacket &) = default;
+	C4NetIOPacket(C4NetIOPacket &&rPacket) noexcept; // (takes over / references data)
+	C4NetIOPacket &operator = (const C4NetIOPacket &) = default;
+
 	~C4NetIOPacket();
 
 protected:
@@ -217,7 +223,7 @@ public:
 
 	// statistics
 	virtual bool GetStatistic(int *pBroadcastRate);
-	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss);
+	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss, int *pResent);
 	virtual void ClearStatistic();
 
 protected:
@@ -362,6 +368,9 @@ public:
 	virtual bool Send(const C4NetIOPacket &rPacket);
 	virtual bool Broadcast(const C4NetIOPacket &rPacket);
 
+	// send multiple packets (using a single system call where supported)
+	bool SendBatch(const C4NetIOPacket *pPackets, size_t iPacketCnt);
+
 	virtual void UnBlock();
 #ifdef STDSCHEDULER_USE_EVENTS
 	virtual HANDLE GetEvent();
@@ -376,7 +385,7 @@ public:
 	virtual bool SetBroadcast(const addr_t &addr, bool fSet = true) { assert(false); return false; }
 
 	virtual bool GetStatistic(int *pBroadcastRate) { assert(false); return false; }
-	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss)
+	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss, int *pResent)
 	{ assert(false); return false; }
 	virtual void ClearStatistic() { assert(false); }
 
@@ -401,6 +410,15 @@ private:
 	// multibind
 	int fAllowReUse;
 
+#ifdef HAVE_RECVMMSG
+	// batched receive: datagrams are read into this buffer and passed on by reference
+	static const unsigned int iRecvBatchSize; // = 8
+	static const size_t iRecvBatchMsgSize; // = 65536
+	StdBuf RecvBatchBuf;
+	bool fInRecvBatch;
+	bool ReceiveBatched();
+#endif
+
 protected:
 
 	// multicast address
@@ -457,7 +475,7 @@ public:
 	virtual C4TimeMilliseconds GetNextTick(C4TimeMilliseconds tNow);
 
 	virtual bool GetStatistic(int *pBroadcastRate);
-	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss);
+	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss, int *pResent);
 	virtual void ClearStatistic();
 
 protected:
@@ -491,6 +509,9 @@ protected:
 
 	static const unsigned int iUDPHeaderSize; // = 8 + 24; // (bytes)
 
+	// outgoing datagrams collected to be sent in one go
+	typedef std::vector<C4NetIOPacket> SendBatch;
+
 	// packet class
 	class PacketList;
 	class Packet
@@ -499,7 +520,7 @@ protected:
 	public:
 
 		// constants / structures
-		static const size_t MaxSize; // = 1024;
+		static const size_t MaxSize; // = 1280;
 		static const size_t MaxDataSize; // = MaxSize - sizeof(Header);
 
 		// types used for packing
@@ -624,7 +645,7 @@ protected:
 		unsigned int iRetries;
 
 		// statistics
-		int iIRate, iORate, iLoss;
+		int iIRate, iORate, iLoss, iResent;
 		CStdCSec StatCSec;
 
 	public:
@@ -635,8 +656,8 @@ protected:
 		// initiate connection
 		bool Connect(bool fFailCallback);
 
-		// send something to this computer
-		bool Send(const C4NetIOPacket &rPacket);
+		// send something to this computer (or add its datagrams to the given batch)
+		bool Send(const C4NetIOPacket &rPacket, SendBatch *pBatch = NULL);
 		// check for lost packets
 		bool Check(bool fForceCheck = true);
 
@@ -671,6 +692,7 @@ protected:
 		int GetIRate() const { return iIRate; }
 		int GetORate() const { return iORate; }
 		int GetLoss() const { return iLoss; }
+		int GetResent() const { return iResent; }
 		void ClearStatistics();
 
 	protected:
@@ -680,8 +702,8 @@ protected:
 		bool DoCheck(int iAskCnt = 0, int iMCAskCnt = 0, unsigned int *pAskList = NULL);
 
 		// sending
-		bool SendDirect(const Packet &rPacket, unsigned int iNr = ~0);
-		bool SendDirect(C4NetIOPacket &&rPacket);
+		bool SendDirect(const Packet &rPacket, unsigned int iNr = ~0, SendBatch *pBatch = NULL);
+		bool SendDirect(C4NetIOPacket &&rPacket, SendBatch *pBatch = NULL);
 
 		// events
 		void OnConn();
@@ -738,8 +760,9 @@ protected:
 	// * helpers
 
 	// sending
-	bool BroadcastDirect(const Packet &rPacket, unsigned int iNr = ~0u); // (mt-safe)
-	bool SendDirect(C4NetIOPacket &&rPacket); // (mt-safe)
+	bool BroadcastDirect(const Packet &rPacket, unsigned int iNr = ~0u, SendBatch *pBatch = NULL); // (mt-safe)
+	bool SendDirect(C4NetIOPacket &&rPacket, SendBatch *pBatch = NULL); // (mt-safe)
+	bool SendDirect(SendBatch &Batch); // (mt-safe)
 
 	// multicast related
 	bool DoLoopbackTest();
@@ -848,6 +871,7 @@ inline void CompileFunc(C4NetIO::addr_t &addr, StdCompiler *pComp)
 bool AcquireWinSock();
 void ReleaseWinSock();
 #endif
+bool ResolveHostName(const char *szHost, in_addr *pAddr); // (mt-safe, WinSock must be initialized)
 bool ResolveAddress(const char *szAddress, C4NetIO::addr_t *paddr, uint16_t iPort);
 
 #endif
@@ -950,10 +950,10 @@ void C4Network2::DrawStatus(C4TargetFacet &cgo)
 		Stat.Append("|Protocols: none");
 
 	// some control statistics
-	Stat.AppendFormat( "|Control: %s, Tick %d, Behind %d, Rate %d, PreSend %d, ACT: %d",
+	Stat.AppendFormat( "|Control: %s, Tick %d, Behind %d, Rate %d, PreSend %d, ACT: %d, Pacing %u",
 	                   Status.getCtrlMode() == CNM_Decentral ? "Decentral" : Status.getCtrlMode() == CNM_Central ? "Central" : "Async",
 	                   ::Control.ControlTick, pControl->GetBehind(::Control.ControlTick),
-	                   ::Control.ControlRate, pControl->getControlPreSend(), pControl->getAvgControlSendTime());
+	                   ::Control.ControlRate, pControl->getControlPreSend(), pControl->getAvgControlSendTime(), pControl->GetPacingDelay());
 
 	// Streaming statistics
 	if (fStreaming)
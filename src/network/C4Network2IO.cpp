@@ -56,6 +56,7 @@ C4Network2IO::C4Network2IO()
 		iTCPIRate(0), iTCPORate(0), iTCPBCRate(0),
 		iUDPIRate(0), iUDPORate(0), iUDPBCRate(0)
 {
+	ZeroMem(PacketStats, sizeof(PacketStats));
 }
 
 C4Network2IO::~C4Network2IO()
@@ -552,8 +553,26 @@ void C4Network2IO::OnPacket(const class C4NetIOPacket &rPacket, C4NetIO *pNetIO)
 #endif
 	// notify
 	pConn->OnPacketReceived(rPacket.getStatus());
-	// handle packet
-	HandlePacket(rPacket, pConn, true);
+	// compressed? Inflate first (always in stream order)
+	if (rPacket.getStatus() == PID_Compressed)
+	{
+		StdBuf Data;
+		if (!pConn->Decompress(rPacket, Data))
+		{
+			Application.InteractiveThread.ThreadLog("Network: could not decompress packet from %s:%d!", inet_ntoa(rPacket.getAddr().sin_addr), htons(rPacket.getAddr().sin_port));
+			pConn->Close();
+			return;
+		}
+		C4NetIOPacket Packet(std::move(Data), rPacket.getAddr());
+		CountPacket(Packet.getStatus(), rPacket.getSize(), false);
+		HandlePacket(Packet, pConn, true);
+	}
+	else
+	{
+		CountPacket(rPacket.getStatus(), rPacket.getSize(), false);
+		// handle packet
+		HandlePacket(rPacket, pConn, true);
+	}
 	// log time
 #if(C4NET2IO_DUMP_LEVEL > 1)
 	uint32_t iHandlingBlocked = C4TimeMilliseconds::Now() - tTime;
@@ -861,7 +880,7 @@ bool C4Network2IO::HandlePacket(const C4NetIOPacket &rPacket, C4Network2IOConnec
 	return fHandled;
 }
 
-void C4Network2IO::CallHandlers(int iHandlerID, const C4IDPacket *pPkt, C4Network2IOConnection *pConn, bool fThread)
+void C4Network2IO::CallHandlers(int iHandlerID, C4IDPacket *pPkt, C4Network2IOConnection *pConn, bool fThread)
 {
 	// emulate old callbacks
 	char cStatus = pPkt->getPktType();
@@ -905,7 +924,11 @@ void C4Network2IO::CallHandlers(int iHandlerID, const C4IDPacket *pPkt, C4Networ
 	// network control (mixed)
 	if (iHandlerID & PH_C4GameControlNetwork)
 	{
-		::Control.Network.HandlePacket(cStatus, pPacket, pConn);
+		// the only handler may take over the packet contents
+		if (iHandlerID == PH_C4GameControlNetwork)
+			::Control.Network.HandlePacket(cStatus, pPkt->getPkt(), pConn);
+		else
+			::Control.Network.HandlePacket(cStatus, pPacket, pConn);
 	}
 }
 
@@ -928,6 +951,8 @@ void C4Network2IO::HandlePacket(char cStatus, const C4PacketBase *pPacket, C4Net
 		GETPKT(C4PacketConn, rPkt)
 		// set connection ID
 		pConn->SetRemoteID(rPkt.getConnID());
+		// peer accepts compressed control packets?
+		pConn->SetCompressControl(rPkt.canCompressControl() && Config.Network.CompressControl);
 		// check auto-accept
 		if (doAutoAccept(rPkt.getCCore(), *pConn))
 		{
@@ -956,6 +981,8 @@ void C4Network2IO::HandlePacket(char cStatus, const C4PacketBase *pPacket, C4Net
 		}
 		// get packet
 		GETPKT(C4PacketConnRe, rPkt)
+		// the accepting side accepts compressed control packets, too?
+		pConn->SetCompressControl(rPkt.canCompressControl() && Config.Network.CompressControl);
 		// auto accept connection
 		if (rPkt.isOK())
 		{
@@ -1173,6 +1200,22 @@ void C4Network2IO::GenerateStatistics(int iInterval)
 	iUDPIRate = iUDPIRateSum; iUDPORate = iUDPORateSum; iUDPBCRate = inUDPBCRate;
 }
 
+void C4Network2IO::CountPacket(uint8_t iPacketType, size_t iSize, bool fOut) // by both
+{
+	CStdLock PacketStatLock(&PacketStatCSec);
+	C4Network2IOPacketStat &Stat = PacketStats[iPacketType];
+	if (fOut)
+		{ Stat.OutCount++; Stat.OutBytes += iSize; }
+	else
+		{ Stat.InCount++; Stat.InBytes += iSize; }
+}
+
+void C4Network2IO::GetPacketStats(C4Network2IOPacketStat *pStats) // by both
+{
+	CStdLock PacketStatLock(&PacketStatCSec);
+	std::copy(PacketStats, PacketStats + 256, pStats);
+}
+
 void C4Network2IO::SendConnPackets()
 {
 	CStdLock ConnListLock(&ConnListCSec);
@@ -1221,6 +1264,8 @@ C4Network2IOConnection::C4Network2IOConnection()
 		tLastPong(C4TimeMilliseconds::NegativeInfinity),
 		fConnSent(false),
 		fPostMortemSent(false),
+		fCompressControl(false),
+		pCompressor(NULL), pDecompressor(NULL),
 		iOutPacketCounter(0), iInPacketCounter(0),
 		pPacketLog(NULL),
 		pNext(NULL),
@@ -1235,6 +1280,9 @@ C4Network2IOConnection::~C4Network2IOConnection()
 	if (pNetClass && !isClosed()) Close();
 	// clear the packet log
 	ClearPacketLog();
+	// free compression states
+	if (pCompressor) { deflateEnd(pCompressor); delete pCompressor; }
+	if (pDecompressor) { inflateEnd(pDecompressor); delete pDecompressor; }
 }
 
 int C4Network2IOConnection::getLag() const
@@ -1393,6 +1441,7 @@ bool C4Network2IOConnection::Send(const C4NetIOPacket &rPkt)
 		assert(isOpen());
 		C4NetIOPacket Copy(rPkt);
 		Copy.SetAddr(PeerAddr);
+		::Network.NetIO.CountPacket(rPkt.getStatus(), rPkt.getSize(), true);
 		return pNetClass->Send(Copy);
 	}
 	CStdLock PacketLogLock(&PacketLogCSec);
@@ -1412,8 +1461,26 @@ bool C4Network2IOConnection::Send(const C4NetIOPacket &rPkt)
 		// okay then
 		return true;
 	}
-	// send
-	bool fSuccess = pNetClass->Send(pLogEntry->Pkt);
+	// send. Control packets get compressed if the peer supports it; the log
+	// keeps them uncompressed, so post mortem recovery isn't affected.
+	bool fSuccess;
+	if (fCompressControl && isCompressedType(rPkt.getStatus()))
+	{
+		StdBuf Data;
+		if (!Compress(pLogEntry->Pkt, Data))
+		{
+			LogF("Network: Fatal: Could not compress packet %02x", rPkt.getStatus());
+			Close();
+			return false;
+		}
+		::Network.NetIO.CountPacket(rPkt.getStatus(), Data.getSize(), true);
+		fSuccess = pNetClass->Send(C4NetIOPacket(std::move(Data), PeerAddr));
+	}
+	else
+	{
+		::Network.NetIO.CountPacket(rPkt.getStatus(), rPkt.getSize(), true);
+		fSuccess = pNetClass->Send(pLogEntry->Pkt);
+	}
 	if (fSuccess)
 		assert(!fPostMortemSent);
 	else {
@@ -1428,6 +1495,96 @@ bool C4Network2IOConnection::Send(const C4NetIOPacket &rPkt)
 	return fSuccess;
 }
 
+void C4Network2IOConnection::SetCompressControl(bool fCompress)
+{
+	CStdLock PacketLogLock(&PacketLogCSec);
+	// can't switch off once the stream has been started
+	fCompressControl = fCompress || pCompressor != NULL;
+}
+
+bool C4Network2IOConnection::Compress(const C4NetIOPacket &rPkt, StdBuf &rOut)
+{
+	// create compressor on first use (raw deflate, the stream lives as long as the connection)
+	if (!pCompressor)
+	{
+		pCompressor = new z_stream;
+		ZeroMem(pCompressor, sizeof(*pCompressor));
+		if (deflateInit2(pCompressor, C4NetCompressLevel, Z_DEFLATED, -C4NetCompressWindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+			{ delete pCompressor; pCompressor = NULL; return false; }
+	}
+	// deflate the whole packet (including status) and flush, so the peer can inflate it right away
+	rOut.New(1 + rPkt.getSize() + rPkt.getSize() / 8 + 64);
+	*getMBufPtr<uint8_t>(rOut) = PID_Compressed;
+	pCompressor->next_in = const_cast<BYTE *>(getBufPtr<BYTE>(rPkt));
+	pCompressor->avail_in = rPkt.getSize();
+	size_t iSize = 1;
+	for (;;)
+	{
+		pCompressor->next_out = getMBufPtr<BYTE>(rOut, iSize);
+		pCompressor->avail_out = rOut.getSize() - iSize;
+		int ret = deflate(pCompressor, Z_SYNC_FLUSH);
+		iSize = rOut.getSize() - pCompressor->avail_out;
+		if (ret != Z_OK && ret != Z_BUF_ERROR)
+			return false;
+		// flush complete?
+		if (pCompressor->avail_out)
+			break;
+		rOut.Grow(rOut.getSize());
+	}
+	// a sync flush always ends with 00 00 FF FF, which the receiver can add back
+	assert(iSize >= 5);
+	rOut.SetSize(iSize - 4);
+	return true;
+}
+
+bool C4Network2IOConnection::Decompress(const C4NetIOPacket &rPkt, StdBuf &rOut)
+{
+	static const BYTE FlushMarker[] = { 0x00, 0x00, 0xFF, 0xFF };
+	// create decompressor on first use
+	if (!pDecompressor)
+	{
+		pDecompressor = new z_stream;
+		ZeroMem(pDecompressor, sizeof(*pDecompressor));
+		if (inflateInit2(pDecompressor, -MAX_WBITS) != Z_OK)
+			{ delete pDecompressor; pDecompressor = NULL; return false; }
+	}
+	// inflate data, then the stripped flush marker
+	rOut.New(rPkt.getPSize() * 4 + 64);
+	size_t iSize = 0;
+	for (int iPart = 0; iPart < 2; iPart++)
+	{
+		pDecompressor->next_in = const_cast<BYTE *>(iPart ? FlushMarker : getBufPtr<BYTE>(rPkt, 1));
+		pDecompressor->avail_in = iPart ? sizeof(FlushMarker) : rPkt.getPSize();
+		for (;;)
+		{
+			pDecompressor->next_out = getMBufPtr<BYTE>(rOut, iSize);
+			pDecompressor->avail_out = rOut.getSize() - iSize;
+			int ret = inflate(pDecompressor, Z_SYNC_FLUSH);
+			iSize = rOut.getSize() - pDecompressor->avail_out;
+			if (ret != Z_OK && ret != Z_BUF_ERROR)
+				return false;
+			if (!pDecompressor->avail_in && pDecompressor->avail_out)
+				break;
+			// no progress possible?
+			if (ret == Z_BUF_ERROR && pDecompressor->avail_out)
+				return false;
+			if (rOut.getSize() >= C4NetCompressMaxSize)
+				return false;
+			rOut.Grow(rOut.getSize());
+		}
+	}
+	// must contain a packet
+	if (!iSize) return false;
+	rOut.SetSize(iSize);
+	return true;
+}
+
+bool C4Network2IOConnection::isCompressedType(uint8_t iPacketType)
+{
+	// control traffic only: small, frequent and highly repetitive
+	return iPacketType >= PID_Control && iPacketType <= PID_ExecSyncCtrl;
+}
+
 void C4Network2IOConnection::SetBroadcastTarget(bool fSet)
 {
 	// Note that each thread will have to make sure that this flag won't be
@@ -1439,17 +1596,17 @@ void C4Network2IOConnection::SetBroadcastTarget(bool fSet)
 void C4Network2IOConnection::DoStatistics(int iInterval, int *pIRateSum, int *pORateSum)
 {
 	// get C4NetIO statistics
-	int inIRate, inORate, inLoss;
-	if (!isOpen() || !pNetClass->GetConnStatistic(PeerAddr, &inIRate, &inORate, &inLoss))
+	int inIRate, inORate, inLoss, inResent;
+	if (!isOpen() || !pNetClass->GetConnStatistic(PeerAddr, &inIRate, &inORate, &inLoss, &inResent))
 	{
-		iIRate = iORate = iPacketLoss = 0;
+		iIRate = iORate = iPacketLoss = iPacketResent = 0;
 		return;
 	}
 	// normalize
 	inIRate = inIRate * 1000 / iInterval;
 	inORate = inORate * 1000 / iInterval;
 	// set
-	iIRate = inIRate; iORate = inORate; iPacketLoss = inLoss;
+	iIRate = inIRate; iORate = inORate; iPacketLoss = inLoss; iPacketResent = inResent;
 	// sum up
 	if (pIRateSum) *pIRateSum += iIRate;
 	if (pORateSum) *pORateSum += iORate;
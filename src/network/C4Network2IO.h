@@ -34,9 +34,21 @@ const int C4NetTimer                = 500,  // ms
           C4NetAcceptTimeout        = 10,   // s
           C4NetPingTimeout          = 30000;// ms
 
+// control stream compression
+const int C4NetCompressLevel        = 6,
+          C4NetCompressWindowBits   = 12,   // 4 KiB history is plenty for control traffic
+          C4NetCompressMaxSize      = 16*1024*1024;
+
 // client count
 const int C4NetMaxClients = 256;
 
+// traffic by packet type (cumulative, wire size)
+struct C4Network2IOPacketStat
+{
+	uint32_t InCount, InBytes;
+	uint32_t OutCount, OutBytes;
+};
+
 class C4Network2IO
 		: protected C4InteractiveThread::Callback,
 		protected C4NetIO::CBClass,
@@ -94,6 +106,8 @@ protected:
 	C4TimeMilliseconds tLastStatistic;
 	int iTCPIRate, iTCPORate, iTCPBCRate,
 	iUDPIRate, iUDPORate, iUDPBCRate;
+	C4Network2IOPacketStat PacketStats[256];
+	CStdCSec PacketStatCSec;
 
 public:
 
@@ -140,6 +154,8 @@ public:
 	int getProtIRate(C4Network2IOProtocol eProt) const { return eProt == P_TCP ? iTCPIRate : iUDPIRate; }
 	int getProtORate(C4Network2IOProtocol eProt) const { return eProt == P_TCP ? iTCPORate : iUDPORate; }
 	int getProtBCRate(C4Network2IOProtocol eProt) const { return eProt == P_TCP ? iTCPBCRate : iUDPBCRate; }
+	void CountPacket(uint8_t iPacketType, size_t iSize, bool fOut); // by both
+	void GetPacketStats(C4Network2IOPacketStat *pStats); // by both (256 entries)
 
 	// reference
 	void SetReference(class C4Network2Reference *pReference);
@@ -174,7 +190,7 @@ protected:
 
 	// general packet handling (= forward in most cases)
 	bool HandlePacket(const C4NetIOPacket &rPacket, C4Network2IOConnection *pConn, bool fThread); // by both
-	void CallHandlers(int iHandlers, const class C4IDPacket *pPacket, C4Network2IOConnection *pConn, bool fThread); // by both
+	void CallHandlers(int iHandlers, class C4IDPacket *pPacket, C4Network2IOConnection *pConn, bool fThread); // by both
 
 	// packet handling (some are really handled here)
 	void HandlePacket(char cStatus, const C4PacketBase *pPacket, C4Network2IOConnection *pConn);
@@ -225,9 +241,12 @@ protected:
 	CStdCSec CCoreCSec;
 	int iIRate, iORate;                     // input/output rates (by C4NetIO, in b/s)
 	int iPacketLoss;                        // lost packets (in the last seconds)
+	int iPacketResent;                      // packets resent on request of the peer (in the last seconds)
 	StdCopyStrBuf Password;                 // password to use for connect
 	bool fConnSent;                         // initial connection packet send
 	bool fPostMortemSent;                   // post mortem send
+	bool fCompressControl;                  // deflate control packets (peer supports it)
+	z_stream *pCompressor, *pDecompressor;  // stream states (created on first use)
 
 	// packet backlog
 	uint32_t iOutPacketCounter, iInPacketCounter;
@@ -263,6 +282,7 @@ public:
 	int       getIRate()      const { return iIRate; }
 	int       getORate()      const { return iORate; }
 	int       getPacketLoss() const { return iPacketLoss; }
+	int       getPacketResent() const { return iPacketResent; }
 	const char *getPassword() const { return Password.getData(); }
 	bool      isConnSent()    const { return fConnSent; }
 
@@ -289,6 +309,10 @@ protected:
 	void SetAutoAccepted();
 	void OnPacketReceived(uint8_t iPacketType);
 	void ClearPacketLog(uint32_t iStartNumber = ~0);
+	void SetCompressControl(bool fCompress);
+	bool Compress(const C4NetIOPacket &rPkt, StdBuf &rOut); // (PacketLogCSec locked)
+	bool Decompress(const C4NetIOPacket &rPkt, StdBuf &rOut); // (network thread)
+	static bool isCompressedType(uint8_t iPacketType);
 
 public:
 	// status changing
@@ -344,12 +368,14 @@ protected:
 	uint32_t iConnID;
 	C4ClientCore CCore;
 	StdCopyStrBuf Password;
+	bool fCompressControl; // accepts PID_Compressed (not sent by older clients)
 
 public:
 	int32_t getVer() const { return iVer; }
 	uint32_t getConnID() const { return iConnID; }
 	const C4ClientCore &getCCore() const { return CCore; }
 	const char *getPassword() const { return Password.getData(); }
+	bool canCompressControl() const { return fCompressControl; }
 
 	virtual void CompileFunc(StdCompiler *pComp);
 };
@@ -363,11 +389,13 @@ public:
 protected:
 	bool fOK, fWrongPassword;
 	StdStrBuf szMsg;
+	bool fCompressControl; // accepts PID_Compressed (not sent by older clients)
 
 public:
 	bool isOK() const { return fOK; }
 	bool isPasswordWrong() const { return fWrongPassword; }
 	const char *getMsg() const { return szMsg.getData(); }
+	bool canCompressControl() const { return fCompressControl; }
 
 	virtual void CompileFunc(StdCompiler *pComp);
 };
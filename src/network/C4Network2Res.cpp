@@ -138,7 +138,7 @@ void C4Network2ResCore::CompileFunc(StdCompiler *pComp)
 // *** C4Network2ResLoad
 
 C4Network2ResLoad::C4Network2ResLoad(int32_t inChunk, int32_t inByClient)
-		: iChunk(inChunk), Timestamp(time(NULL)), iByClient(inByClient), pNext(NULL)
+		: iChunk(inChunk), Timestamp(C4TimeMilliseconds::Now()), iByClient(inByClient), pNext(NULL)
 {
 
 }
@@ -148,9 +148,9 @@ C4Network2ResLoad::~C4Network2ResLoad()
 
 }
 
-bool C4Network2ResLoad::CheckTimeout()
+bool C4Network2ResLoad::CheckTimeout(uint32_t iTimeout)
 {
-	return difftime(time(NULL), Timestamp) >= C4NetResLoadTimeout;
+	return getAge() >= iTimeout;
 }
 
 // *** C4Network2ResChunkData
@@ -360,6 +360,7 @@ C4Network2Res::C4Network2Res(C4Network2ResList *pnParent)
 		iLastReqTime(0),
 		fLoading(false),
 		pCChunks(NULL), iDiscoverStartTime(0), pLoads(NULL), iLoadCnt(0),
+		iLoadFile(-1),
 		pNext(NULL),
 		pParent(pnParent)
 {
@@ -492,6 +493,42 @@ bool C4Network2Res::SetByCore(const C4Network2ResCore &nCore, bool fSilent, cons
 	return false;
 }
 
+bool C4Network2Res::SetByCache(const C4Network2ResCore &nCore) // by main thread
+{
+	// get name of the cache entry
+	char szCacheFile[_MAX_PATH + 1];
+	if (!pParent->GetCacheFileName(nCore, szCacheFile)) return false;
+	if (!FileExists(szCacheFile)) return false;
+	// the cached file must be binary identical to the official version
+	uint32_t iCRC32; BYTE hash[SHA_DIGEST_LENGTH];
+	if (FileSize(szCacheFile) != nCore.getFileSize() ||
+	    !GetFileCRC(szCacheFile, &iCRC32) || iCRC32 != nCore.getFileCRC() ||
+	    (nCore.hasFileSHA() && (!GetFileSHA1(szCacheFile, hash) || memcmp(hash, nCore.getFileSHA(), SHA_DIGEST_LENGTH))))
+	{
+		// broken entry: remove it
+		EraseItem(szCacheFile);
+		return false;
+	}
+	// mark as recently used, so pruning removes the least recently used entries first
+	TouchFile(szCacheFile);
+	Clear();
+	CStdLock FileLock(&FileCSec);
+	// use the cache entry as file and standalone
+	SCopy(szCacheFile, szFile, sizeof(szFile) - 1);
+	SCopy(szCacheFile, szStandalone, sizeof(szStandalone) - 1);
+	// set core, chunks
+	Core = nCore;
+	Chunks.SetComplete(Core.getChunkCnt());
+	// set flags
+	fDirty = true;
+	fTempFile = false;
+	fStandaloneFailed = false;
+	fRemoved = false;
+	iLastReqTime = time(NULL);
+	fLoading = false;
+	return true;
+}
+
 bool C4Network2Res::SetLoad(const C4Network2ResCore &nCore) // by main thread
 {
 	Clear();
@@ -874,10 +911,7 @@ void C4Network2Res::OnStatus(const C4Network2ResChunkData &rChunkData, C4Network
 	if (rChunkData.getChunkCnt() != Chunks.getChunkCnt())
 		return;
 	// add chunk data
-	ClientChunks *pChunks;
-	for (pChunks = pCChunks; pChunks; pChunks = pChunks->Next)
-		if (pChunks->ClientID == pBy->getClientID())
-			break;
+	ClientChunks *pChunks = GetCChunks(pBy->getClientID());
 	// not found? add
 	if (!pChunks)
 	{
@@ -887,9 +921,13 @@ void C4Network2Res::OnStatus(const C4Network2ResChunkData &rChunkData, C4Network
 	}
 	pChunks->ClientID = pBy->getClientID();
 	pChunks->Chunks = rChunkData;
-	// check load
-	if (!StartLoad(pChunks->ClientID, pChunks->Chunks))
-		RemoveCChunks(pCChunks);
+	// fill the client's transfer window
+	for (int32_t iPrevLoadCnt = -1; iLoadCnt > iPrevLoadCnt; )
+	{
+		iPrevLoadCnt = iLoadCnt;
+		if (!StartLoad(pChunks->ClientID, pChunks->Chunks))
+			{ RemoveCChunks(pChunks); break; }
+	}
 }
 
 void C4Network2Res::OnChunk(const C4Network2ResChunk &rChunk)
@@ -913,7 +951,18 @@ void C4Network2Res::OnChunk(const C4Network2ResChunk &rChunk)
 		{
 			pNext = pLoad->Next();
 			if (static_cast<uint32_t>(pLoad->getChunk()) == rChunk.getChunkNr())
+			{
+				// update transfer window of the client that delivered
+				ClientChunks *pChunks = GetCChunks(pLoad->getByClient());
+				if (pChunks)
+				{
+					uint32_t iRTT = pLoad->getAge();
+					pChunks->RTT = pChunks->RTT ? (pChunks->RTT * 7 + iRTT) / 8 : iRTT;
+					if (pChunks->MaxLoad < C4NetResMaxClientLoad)
+						pChunks->MaxLoad++;
+				}
 				RemoveLoad(pLoad);
+			}
 		}
 	}
 	// complete?
@@ -935,8 +984,12 @@ bool C4Network2Res::DoLoad()
 		for (C4Network2ResLoad *pLoad = pLoads, *pNext; pLoad; pLoad = pNext)
 		{
 			pNext = pLoad->Next();
-			if (pLoad->CheckTimeout())
+			ClientChunks *pChunks = GetCChunks(pLoad->getByClient());
+			if (pLoad->CheckTimeout(pChunks ? pChunks->getLoadTimeout() : C4NetResLoadTimeout * 1000))
 			{
+				// shrink transfer window
+				if (pChunks)
+					pChunks->MaxLoad = std::max<int32_t>(pChunks->MaxLoad / 2, 1);
 				RemoveLoad(pLoad);
 				iLoadsRemoved++;
 			}
@@ -972,6 +1025,8 @@ bool C4Network2Res::NeedsDiscover()
 void C4Network2Res::Clear()
 {
 	CStdLock FileLock(&FileCSec);
+	// stop loading (closes the load file)
+	ClearLoad();
 	// delete files
 	if (fTempFile)
 		if (FileExists(szFile))
@@ -987,7 +1042,6 @@ void C4Network2Res::Clear()
 	Core.Clear();
 	Chunks.Clear();
 	fRemoved = false;
-	ClearLoad();
 }
 
 int32_t C4Network2Res::OpenFileRead()
@@ -1039,7 +1093,7 @@ void C4Network2Res::StartNewLoads()
 			}
 	}
 	// start new load until maximum count reached
-	while (iLoadCnt + 1 <= C4NetResMaxLoad)
+	while (iLoadCnt < C4NetResMaxLoad)
 	{
 		int32_t ioLoadCnt = iLoadCnt;
 		// search someone
@@ -1064,15 +1118,19 @@ bool C4Network2Res::StartLoad(int32_t iFromClient, const C4Network2ResChunkData
 {
 	assert(pParent && pParent->getIOClass());
 	// all slots used? ignore
-	if (iLoadCnt + 1 >= C4NetResMaxLoad) return true;
-	// is there already a load by this client? ignore
-	for (C4Network2ResLoad *pPos = pLoads; pPos; pPos = pPos->Next())
-		if (pPos->getByClient() == iFromClient)
-			return true;
-	// find chunk to retrieve
-	int32_t iLoads[C4NetResMaxLoad]; int32_t i = 0;
+	if (iLoadCnt >= C4NetResMaxLoad) return true;
+	// find chunks already being retrieved
+	int32_t iLoads[C4NetResMaxLoad]; int32_t i = 0, iClientLoadCnt = 0;
 	for (C4Network2ResLoad *pLoad = pLoads; pLoad; pLoad = pLoad->Next())
+	{
 		iLoads[i++] = pLoad->getChunk();
+		if (pLoad->getByClient() == iFromClient) iClientLoadCnt++;
+	}
+	// transfer window of this client full? ignore
+	ClientChunks *pChunks = GetCChunks(iFromClient);
+	if (iClientLoadCnt >= (pChunks ? pChunks->MaxLoad : 1))
+		return true;
+	// find chunk to retrieve
 	int32_t iRetrieveChunk = Chunks.GetChunkToRetrieve(Available, i, iLoads);
 	// nothing? ignore
 	if (iRetrieveChunk < 0 || (uint32_t)iRetrieveChunk >= Core.getChunkCnt())
@@ -1105,6 +1163,8 @@ void C4Network2Res::EndLoad()
 	ClearLoad();
 	// set complete
 	fLoading = false;
+	// keep the file for later rounds
+	pParent->AddToCache(this);
 	// call handler
 	assert(pParent);
 	pParent->OnResComplete(this);
@@ -1114,9 +1174,10 @@ void C4Network2Res::ClearLoad()
 {
 	// remove client chunks and loads
 	fLoading = false;
-	while (pCChunks) RemoveCChunks(pCChunks);
 	while (pLoads) RemoveLoad(pLoads);
+	while (pCChunks) RemoveCChunks(pCChunks);
 	iDiscoverStartTime = iLoadCnt = 0;
+	CloseLoadFile();
 }
 
 void C4Network2Res::RemoveLoad(C4Network2ResLoad *pLoad)
@@ -1154,6 +1215,37 @@ void C4Network2Res::RemoveCChunks(ClientChunks *pChunks)
 	delete pChunks;
 }
 
+C4Network2Res::ClientChunks *C4Network2Res::GetCChunks(int32_t iClientID) const
+{
+	for (ClientChunks *pChunks = pCChunks; pChunks; pChunks = pChunks->Next)
+		if (pChunks->ClientID == iClientID)
+			return pChunks;
+	return NULL;
+}
+
+uint32_t C4Network2Res::ClientChunks::getLoadTimeout() const
+{
+	// no measurement yet? be patient
+	if (!RTT) return C4NetResLoadTimeout * 1000;
+	// allow for some jitter and the rest of the window being queued in front of the chunk
+	return Clamp<uint32_t>(RTT * 4, C4NetResMinLoadTimeout * 1000, C4NetResLoadTimeout * 1000);
+}
+
+int32_t C4Network2Res::GetLoadFile()
+{
+	// open on first chunk, keep open until the load ends
+	if (iLoadFile == -1 && fLoading)
+		iLoadFile = OpenFileWrite();
+	return iLoadFile;
+}
+
+void C4Network2Res::CloseLoadFile()
+{
+	if (iLoadFile == -1) return;
+	close(iLoadFile);
+	iLoadFile = -1;
+}
+
 bool C4Network2Res::OptimizeStandalone(bool fSilent)
 {
 	CStdLock FileLock(&FileCSec);
@@ -1205,7 +1297,7 @@ bool C4Network2ResChunk::Set(C4Network2Res *pRes, uint32_t inChunk)
 	iChunk = inChunk;
 	// calculate offset and size
 	int32_t iOffset = iChunk * Core.getChunkSize(),
-	                  iSize = std::min<int32_t>(Core.getFileSize() - iOffset, C4NetResChunkSize);
+	                  iSize = std::min<int32_t>(Core.getFileSize() - iOffset, Core.getChunkSize());
 	if (iSize < 0) { LogF("Network: could not get chunk from offset %d from resource file %s: File size is only %d!", iOffset, pRes->getFile(), Core.getFileSize()); return false; }
 	// open file
 	int32_t f = pRes->OpenFileRead();
@@ -1247,8 +1339,8 @@ bool C4Network2ResChunk::AddTo(C4Network2Res *pRes, C4Network2IO *pIO) const
 #endif
 		return false;
 	}
-	// open file
-	int32_t f = pRes->OpenFileWrite();
+	// get file (kept open by the resource while loading)
+	int32_t f = pRes->GetLoadFile();
 	if (f == -1)
 	{
 #ifdef C4NET2RES_DEBUG_LOG
@@ -1257,26 +1349,22 @@ bool C4Network2ResChunk::AddTo(C4Network2Res *pRes, C4Network2IO *pIO) const
 		return false;
 	}
 	// seek
-	if (iOffset)
-		if (lseek(f, iOffset, SEEK_SET) != iOffset)
-		{
+	if (lseek(f, iOffset, SEEK_SET) != iOffset)
+	{
 #ifdef C4NET2RES_DEBUG_LOG
-			Application.InteractiveThread.ThreadLogS("C4Network2ResChunk(%d)::AddTo(%s [%d]): lseek file error: %s!", (int) iResID, (const char *) Core.getFileName(), (int) pRes->getResID(), strerror(errno));
+		Application.InteractiveThread.ThreadLogS("C4Network2ResChunk(%d)::AddTo(%s [%d]): lseek file error: %s!", (int) iResID, (const char *) Core.getFileName(), (int) pRes->getResID(), strerror(errno));
 #endif
-			close(f);
-			return false;
-		}
+		return false;
+	}
 	// write
 	if (write(f, Data.getData(), Data.getSize()) != int32_t(Data.getSize()))
 	{
 #ifdef C4NET2RES_DEBUG_LOG
 		Application.InteractiveThread.ThreadLogS("C4Network2ResChunk(%d)::AddTo(%s [%d]): write error: %s!", (int) iResID, (const char *) Core.getFileName(), (int) pRes->getResID(), strerror(errno));
 #endif
-		close(f);
 		return false;
 	}
 	// ok, add chunks
-	close(f);
 	pRes->Chunks.AddChunk(iChunk);
 	return true;
 }
@@ -1470,6 +1558,13 @@ C4Network2Res::Ref C4Network2ResList::AddByCore(const C4Network2ResCore &Core, b
 	// try set by core
 	if (!pRes->SetByCore(Core, true))
 	{
+		// try the resource cache
+		if (pRes->SetByCache(Core))
+		{
+			Application.InteractiveThread.ThreadLogS("Network: Found %s in resource cache. Not loading.", pRes->getCore().getFileName());
+			Add(pRes);
+			return pRes;
+		}
 		pRes.Clear();
 		// try load (if specified)
 		return fLoad ? AddLoad(Core) : NULL;
@@ -1750,3 +1845,81 @@ bool C4Network2ResList::FindTempResFileName(const char *szFilename, char *pTarge
 	// not found
 	return false;
 }
+
+bool C4Network2ResList::IsCacheable(const C4Network2ResCore &Core) const
+{
+	if (Config.Network.ResCacheSize <= 0 || !Core.isLoadable()) return false;
+	// players and dynamic data change every round: not worth keeping
+	switch (Core.getType())
+	{
+	case NRT_Scenario: case NRT_Definitions: case NRT_System: case NRT_Material:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool C4Network2ResList::GetCacheFileName(const C4Network2ResCore &Core, char *pTarget) const
+{
+	if (!IsCacheable(Core)) return false;
+	// keep (a sanitized version of) the extension so the entry is recognizable
+	char szExt[9]; int32_t i = 0;
+	for (const char *szOrgExt = GetExtension(Core.getFileName()); i < 8 && isalnum(static_cast<unsigned char>(*szOrgExt)); szOrgExt++)
+		szExt[i++] = *szOrgExt;
+	szExt[i] = '\0';
+	// entries are keyed by file checksum and size
+	char szName[_MAX_PATH + 1];
+	snprintf(szName, _MAX_PATH, "%s%c%08x_%u%s%s", C4CFN_NetResCache, DirectorySeparator,
+	         (unsigned int) Core.getFileCRC(), (unsigned int) Core.getFileSize(), *szExt ? "." : "", szExt);
+	SCopy(Config.AtNetworkPath(szName), pTarget, _MAX_PATH);
+	return true;
+}
+
+void C4Network2ResList::AddToCache(C4Network2Res *pRes) // by network thread
+{
+	char szCacheFile[_MAX_PATH + 1];
+	if (!GetCacheFileName(pRes->getCore(), szCacheFile)) return;
+	// already cached (might have been loaded twice at once)?
+	if (ItemExists(szCacheFile)) return;
+	// create cache folder
+	char szCachePath[_MAX_PATH + 1];
+	SCopy(Config.AtNetworkPath(C4CFN_NetResCache), szCachePath, _MAX_PATH);
+	if (!DirectoryExists(szCachePath))
+		if (!CreatePath(szCachePath))
+			return;
+	// move the loaded file into the cache and use it from there
+	CStdLock FileLock(&pRes->FileCSec);
+	if (!MoveItem(pRes->szFile, szCacheFile))
+		{ Application.InteractiveThread.ThreadLogS("Network: Could not add %s to resource cache!", pRes->getCore().getFileName()); return; }
+	SCopy(szCacheFile, pRes->szFile, sizeof(pRes->szFile) - 1);
+	SCopy(szCacheFile, pRes->szStandalone, sizeof(pRes->szStandalone) - 1);
+	pRes->fTempFile = false;
+	// keep within size limit
+	PruneCache();
+}
+
+void C4Network2ResList::PruneCache() // by network thread
+{
+	// collect entries
+	struct CacheEntry { int Time; size_t Size; std::string File; };
+	std::vector<CacheEntry> Entries;
+	char szCachePath[_MAX_PATH + 1];
+	SCopy(Config.AtNetworkPath(C4CFN_NetResCache), szCachePath, _MAX_PATH);
+	for (DirectoryIterator i(szCachePath); *i; ++i)
+		if (!DirectoryExists(*i))
+		{
+			CacheEntry Entry = { FileTime(*i), FileSize(*i), *i };
+			Entries.push_back(Entry);
+		}
+	// most recently used first
+	std::sort(Entries.begin(), Entries.end(), [](const CacheEntry &a, const CacheEntry &b) { return a.Time > b.Time; });
+	// remove least recently used entries exceeding the limit, unless in use
+	size_t iTotalSize = 0, iMaxSize = size_t(Config.Network.ResCacheSize) * 1024 * 1024;
+	for (std::vector<CacheEntry>::const_iterator it = Entries.begin(); it != Entries.end(); ++it)
+	{
+		iTotalSize += it->Size;
+		if (iTotalSize > iMaxSize && !getRes(it->File.c_str(), false))
+			if (EraseItem(it->File.c_str()))
+				iTotalSize -= it->Size;
+	}
+}
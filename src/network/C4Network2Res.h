@@ -23,13 +23,16 @@
 
 #include <SHA1.h>
 
-const uint32_t C4NetResChunkSize = 10U * 1024U;
+const uint32_t C4NetResChunkSize = 32U * 1024U;
 
 const int32_t C4NetResDiscoverTimeout = 10, // (s)
               C4NetResDiscoverInterval = 1, // (s)
               C4NetResStatusInterval = 1, // (s)
-              C4NetResMaxLoad = 5,
-              C4NetResLoadTimeout = 60, // (s)
+              C4NetResMaxLoad = 64, // maximum number of outstanding chunk requests per resource
+              C4NetResMinClientLoad = 2, // initial number of outstanding chunk requests per client
+              C4NetResMaxClientLoad = 32, // upper bound of the per-client transfer window
+              C4NetResLoadTimeout = 60, // (s) - upper bound of the adaptive load timeout
+              C4NetResMinLoadTimeout = 5, // (s) - lower bound of the adaptive load timeout
               C4NetResDeleteTime = 60, // (s)
               C4NetResMaxBigicon = 20; // maximum size, in KB, of bigicon
 
@@ -114,7 +117,7 @@ public:
 protected:
 	// chunk download data
 	int32_t iChunk;
-	time_t Timestamp;
+	C4TimeMilliseconds Timestamp;
 	int32_t iByClient;
 
 	// list (C4Network2Res)
@@ -123,10 +126,11 @@ protected:
 public:
 	int32_t     getChunk()        const { return iChunk; }
 	int32_t     getByClient()     const { return iByClient; }
+	uint32_t    getAge()          const { return C4TimeMilliseconds::Now() - Timestamp; } // (ms)
 
 	C4Network2ResLoad *Next() const { return pNext; }
 
-	bool CheckTimeout();
+	bool CheckTimeout(uint32_t iTimeout);
 
 };
 
@@ -222,11 +226,21 @@ protected:
 
 	// loading
 	bool fLoading;
-	struct ClientChunks { C4Network2ResChunkData Chunks; int32_t ClientID; ClientChunks *Next; }
+	// per-client transfer window: grows with every chunk received, halves on timeout
+	struct ClientChunks
+	{
+		C4Network2ResChunkData Chunks; int32_t ClientID;
+		int32_t MaxLoad; // maximum number of outstanding requests to this client
+		uint32_t RTT; // (ms) smoothed request round trip time, 0 if not measured yet
+		ClientChunks *Next;
+		ClientChunks() : ClientID(-1), MaxLoad(C4NetResMinClientLoad), RTT(0), Next(NULL) { }
+		uint32_t getLoadTimeout() const;
+	}
 	*pCChunks;
 	time_t iDiscoverStartTime;
 	C4Network2ResLoad *pLoads;
 	int32_t iLoadCnt;
+	int32_t iLoadFile; // write handle held open while loading
 
 	// list (C4Network2ResList)
 	C4Network2Res *pNext;
@@ -251,6 +265,7 @@ public:
 	bool SetByFile(const char *strFilePath, bool fTemp, C4Network2ResType eType, int32_t iResID, const char *szResName = NULL, bool fSilent = false);
 	bool SetByGroup(C4Group *pGrp, bool fTemp, C4Network2ResType eType, int32_t iResID, const char *szResName = NULL, bool fSilent = false);
 	bool SetByCore(const C4Network2ResCore &nCore, bool fSilent = false, const char *szAsFilename = NULL, int32_t iRecursion=0);
+	bool SetByCache(const C4Network2ResCore &nCore);
 	bool SetLoad(const C4Network2ResCore &nCore);
 
 	bool SetDerived(const char *strName, const char *strFilePath, bool fTemp, C4Network2ResType eType, int32_t iDResID);
@@ -295,6 +310,9 @@ protected:
 
 	void RemoveLoad(C4Network2ResLoad *pLoad);
 	void RemoveCChunks(ClientChunks *pChunks);
+	ClientChunks *GetCChunks(int32_t iClientID) const;
+	int32_t GetLoadFile();
+	void CloseLoadFile();
 
 	bool OptimizeStandalone(bool fSilent);
 
@@ -391,6 +409,12 @@ protected:
 	bool CreateNetworkFolder();
 	bool FindTempResFileName(const char *szFilename, char *pTarget);
 
+	// content-addressed cache of downloaded resources
+	bool IsCacheable(const C4Network2ResCore &Core) const;
+	bool GetCacheFileName(const C4Network2ResCore &Core, char *pTarget) const;
+	void AddToCache(C4Network2Res *pRes);
+	void PruneCache();
+
 };
 
 // * Packets *
@@ -305,6 +305,10 @@ C4Network2Stats::C4Network2Stats()
 	Application.Add(this);
 	SecondCounter = 0;
 	ControlCounter = 0;
+	tLastMetrics = C4TimeMilliseconds::Now();
+	::Network.NetIO.GetPacketStats(LastPacketStats);
+	iLastControlWaitTime = ::Control.Network.getControlWaitTime();
+	iLastLinkAllocations = C4ObjectLink::GetPoolStats().Allocations;
 	// init graphs
 	statObjCount.SetTitle(LoadResStr("IDS_MSG_OBJCOUNT"));
 	statFPS.SetTitle(LoadResStr("IDS_MSG_FPS"));
@@ -350,6 +354,104 @@ void C4Network2Stats::ExecuteSecond()
 			pClient->getStatPing()->RecordValue(C4Graph::ValueType(iPing));
 		}
 	++SecondCounter;
+	// metrics export
+	if (*Config.Network.MetricsFile && ::Network.isEnabled())
+		if (!(SecondCounter % std::max<int32_t>(Config.Network.MetricsInterval, 1)))
+			WriteMetrics(Config.Network.MetricsFile);
+}
+
+// counter delta per second; widened so byte counts don't overflow when scaled to ms
+static int PerSecond(uint32_t iDelta, int32_t iInterval)
+{
+	return (int) (uint64_t(iDelta) * 1000 / iInterval);
+}
+
+bool C4Network2Stats::WriteMetrics(const char *szFilename)
+{
+	// all rates are per second, times in ms
+	C4TimeMilliseconds tNow = C4TimeMilliseconds::Now();
+	int32_t iInterval = std::max<int32_t>(tNow - tLastMetrics, 1);
+	tLastMetrics = tNow;
+	StdStrBuf Out;
+	// game: low FPS with little control wait means the host is CPU-bound
+	uint32_t iControlWaitTime = ::Control.Network.getControlWaitTime();
+	Out.Append("[Game]" LineFeed);
+	Out.AppendFormat("Frame=%d" LineFeed, (int) Game.FrameCounter);
+	Out.AppendFormat("FPS=%d" LineFeed, (int) Game.FPS);
+	Out.AppendFormat("ObjectCount=%d" LineFeed, (int) ::Objects.ObjectCount());
+	Out.AppendFormat("ControlRate=%d" LineFeed, (int) ::Control.ControlRate);
+	Out.AppendFormat("ControlPreSend=%d" LineFeed, (int) ::Control.Network.getControlPreSend());
+	Out.AppendFormat("AvgControlSendTime=%d" LineFeed, (int) ::Control.Network.getAvgControlSendTime());
+	Out.AppendFormat("ControlWaitTime=%d" LineFeed, PerSecond(iControlWaitTime - iLastControlWaitTime, iInterval));
+	Out.AppendFormat("ControlPacing=%d" LineFeed, (int) ::Control.Network.GetPacingDelay());
+	iLastControlWaitTime = iControlWaitTime;
+	// object list links: in use, owned by the pool, allocations per second
+	const C4ObjectLink::PoolStats &LinkStats = C4ObjectLink::GetPoolStats();
+	Out.AppendFormat("ObjectLinks=%d,%d,%d" LineFeed, (int) LinkStats.InUse, (int) LinkStats.Pooled,
+	                 PerSecond(LinkStats.Allocations - iLastLinkAllocations, iInterval));
+	iLastLinkAllocations = LinkStats.Allocations;
+	// overall traffic
+	Out.Append(LineFeed "[Traffic]" LineFeed);
+	Out.AppendFormat("TCPIn=%d" LineFeed "TCPOut=%d" LineFeed, ::Network.NetIO.getProtIRate(P_TCP), ::Network.NetIO.getProtORate(P_TCP));
+	Out.AppendFormat("UDPIn=%d" LineFeed "UDPOut=%d" LineFeed, ::Network.NetIO.getProtIRate(P_UDP), ::Network.NetIO.getProtORate(P_UDP));
+	// traffic by packet type: packets in, bytes in, packets out, bytes out
+	// (resource transfer throughput is "Resource Data")
+	C4Network2IOPacketStat PacketStats[256];
+	::Network.NetIO.GetPacketStats(PacketStats);
+	Out.Append(LineFeed "[Packets]" LineFeed);
+	bool fListed[256] = { };
+	for (const C4PktHandlingData *pHData = PktHandlingData; pHData->ID != PID_None; pHData++)
+	{
+		// types handled by multiple handlers are listed multiple times
+		if (pHData->Class != PC_Network || fListed[pHData->ID]) continue;
+		fListed[pHData->ID] = true;
+		const C4Network2IOPacketStat &Stat = PacketStats[pHData->ID], &Last = LastPacketStats[pHData->ID];
+		if (Stat.InCount == Last.InCount && Stat.OutCount == Last.OutCount) continue;
+		StdCopyStrBuf Name(pHData->Name); Name.ReplaceChar(' ', '_');
+		Out.AppendFormat("%s=%d,%d,%d,%d" LineFeed, Name.getData(),
+		                 PerSecond(Stat.InCount - Last.InCount, iInterval), PerSecond(Stat.InBytes - Last.InBytes, iInterval),
+		                 PerSecond(Stat.OutCount - Last.OutCount, iInterval), PerSecond(Stat.OutBytes - Last.OutBytes, iInterval));
+	}
+	std::copy(PacketStats, PacketStats + 256, LastPacketStats);
+	// clients
+	C4Network2Client *pClient = NULL;
+	while ((pClient = ::Network.Clients.GetNextClient(pClient)))
+	{
+		if (pClient->isLocal()) continue;
+		Out.Append(LineFeed "[Client]" LineFeed);
+		Out.AppendFormat("ID=%d" LineFeed, (int) pClient->getID());
+		Out.AppendFormat("Name=%s" LineFeed, pClient->getName());
+		Out.AppendFormat("NextControl=%d" LineFeed, (int) ::Control.Network.ClientNextControl(pClient->getID()));
+		// latency model used for PreSend: smoothed ping, jitter, 90th percentile
+		int32_t iAvgPing, iPingJitter, iHighPing;
+		if (::Control.Network.GetClientLatency(pClient->getID(), &iAvgPing, &iPingJitter, &iHighPing))
+			Out.AppendFormat("Latency=%d,%d,%d" LineFeed, (int) iAvgPing, (int) iPingJitter, (int) iHighPing);
+		// ping distribution over the last minute
+		C4TableGraph *pPing = pClient->getStatPing();
+		if (pPing && pPing->GetEndTime() > pPing->GetStartTime())
+		{
+			std::vector<C4Graph::ValueType> Pings;
+			for (C4Graph::TimeType t = std::max(pPing->GetStartTime(), pPing->GetEndTime() - 60); t < pPing->GetEndTime(); ++t)
+				Pings.push_back(pPing->GetAtValue(t));
+			std::sort(Pings.begin(), Pings.end());
+			Out.AppendFormat("Ping=%d,%d,%d,%d" LineFeed, (int) Pings.front(), (int) Pings[Pings.size() / 2],
+			                 (int) Pings[Pings.size() * 9 / 10], (int) Pings.back());
+		}
+		// connections: protocol, lag, bytes in, bytes out, packets lost, packets resent
+		C4Network2IOConnection *pConns[2] = { pClient->getMsgConn(), pClient->getDataConn() };
+		for (int i = 0; i < 2; i++)
+			if (pConns[i] && (!i || pConns[i] != pConns[0]))
+				Out.AppendFormat("%s=%s,%d,%d,%d,%d,%d" LineFeed, i ? "DataConn" : "MsgConn",
+				                 pConns[i]->getProtocol() == P_TCP ? "TCP" : "UDP", pConns[i]->getLag(),
+				                 pConns[i]->getIRate(), pConns[i]->getORate(), pConns[i]->getPacketLoss(), pConns[i]->getPacketResent());
+	}
+	// write to temp file first, so readers never see partial data
+	StdStrBuf TempFilename(szFilename); TempFilename.Append(".tmp");
+	if (!Out.SaveToFile(TempFilename.getData())) return false;
+	if (!RenameFile(TempFilename.getData(), szFilename))
+		if (!EraseFile(szFilename) || !RenameFile(TempFilename.getData(), szFilename))
+			return false;
+	return true;
 }
 
 void C4Network2Stats::ExecuteControlFrame()
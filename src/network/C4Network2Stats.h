@@ -19,6 +19,7 @@
 #define INC_C4Network2Stats
 
 #include "C4Application.h"
+#include "C4Network2IO.h"
 #include "StdBuf.h"
 
 #include <algorithm>
@@ -187,6 +188,12 @@ protected:
 	int SecondCounter; // seconds passed in measured time by network stats module
 	int ControlCounter; // control frames passed in measured time by network stats module
 
+	// metrics export (see Config.Network.MetricsFile)
+	C4TimeMilliseconds tLastMetrics;
+	C4Network2IOPacketStat LastPacketStats[256];
+	uint32_t iLastControlWaitTime;
+	uint32_t iLastLinkAllocations;
+
 	friend class C4Player;
 	friend class C4Network2Client;
 
@@ -201,6 +208,9 @@ public:
 
 	virtual void OnSec1Timer() { ExecuteSecond(); }
 
+	// write current network metrics to file
+	bool WriteMetrics(const char *szFilename);
+
 	C4Graph *GetGraphByName(const StdStrBuf &rszName, bool &rfIsTemp);
 };
 
@@ -409,7 +409,8 @@ void C4PacketList::CompileFunc(StdCompiler *pComp)
 // *** C4PacketConn
 
 C4PacketConn::C4PacketConn()
-		: iVer(C4XVER1*100 + C4XVER2)
+		: iVer(C4XVER1*100 + C4XVER2),
+		fCompressControl(false)
 {
 }
 
@@ -417,7 +418,8 @@ C4PacketConn::C4PacketConn(const C4ClientCore &nCCore, uint32_t inConnID, const
 		: iVer(C4XVER1*100 + C4XVER2),
 		iConnID(inConnID),
 		CCore(nCCore),
-		Password(szPassword)
+		Password(szPassword),
+		fCompressControl(!!Config.Network.CompressControl)
 {
 }
 
@@ -427,18 +429,30 @@ void C4PacketConn::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iVer), "Version", -1));
 	pComp->Value(mkNamingAdapt(Password, "Password", ""));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iConnID), "ConnID", ~0u));
+	// appended field: older clients ignore it and don't send it
+	try
+	{
+		pComp->Value(mkNamingAdapt(fCompressControl, "CompressControl", false));
+	}
+	catch (StdCompiler::EOFException *pExc)
+	{
+		delete pExc;
+		fCompressControl = false;
+	}
 }
 
 // *** C4PacketConnRe
 
 C4PacketConnRe::C4PacketConnRe()
+		: fCompressControl(false)
 {
 }
 
 C4PacketConnRe::C4PacketConnRe(bool fnOK, bool fWrongPassword, const char *sznMsg)
 		: fOK(fnOK),
 		fWrongPassword(fWrongPassword),
-		szMsg(sznMsg, true)
+		szMsg(sznMsg, true),
+		fCompressControl(!!Config.Network.CompressControl)
 {
 }
 
@@ -447,6 +461,16 @@ void C4PacketConnRe::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(fOK, "OK", true));
 	pComp->Value(mkNamingAdapt(szMsg, "Message", ""));
 	pComp->Value(mkNamingAdapt(fWrongPassword, "WrongPassword", false));
+	// appended field, see C4PacketConn
+	try
+	{
+		pComp->Value(mkNamingAdapt(fCompressControl, "CompressControl", false));
+	}
+	catch (StdCompiler::EOFException *pExc)
+	{
+		delete pExc;
+		fCompressControl = false;
+	}
 }
 
 // *** C4PacketFwd
@@ -294,7 +294,7 @@ void C4Command::MoveTo()
 						PathChecked=true;
 				}
 	// Path recheck
-	if (!::Game.iTick35) PathChecked=false;
+	if (::Game.IsObjectTick(35, cObj->Number)) PathChecked=false;
 
 	// Pushing grab only or not desired: let go (pulling, too?)
 	if (cObj->GetProcedure()==DFA_PUSH)
@@ -1581,7 +1581,7 @@ void C4Command::Transfer()
 	}
 
 	// Call target transfer script
-	if (!::Game.iTick5)
+	if (::Game.IsObjectTick(5, cObj->Number))
 	{
 		if (!Target->Call(PSF_ControlTransfer, &C4AulParSet(C4VObj(cObj), Tx, C4VInt(Ty))).getBool())
 			// Transfer not handled by target: done
@@ -201,6 +201,24 @@ void C4GameObjects::UpdateSolidMasks()
 			obj->UpdateSolidMask(false);
 }
 
+void C4GameObjects::UpdateMeshPoses(const C4Rect &rect, int32_t iPlayer)
+{
+	// collect mesh instances of objects drawn in rect; attached meshes are updated with their parent
+	// poses of other meshes are only computed if they get drawn anyway or a script asks for a bone
+	std::vector<StdMeshInstance *> instances;
+	C4LArea Area(&Sectors, rect);
+	C4LSector *pSct;
+	for (C4ObjectList *pLst = Area.FirstObjects(&pSct); pLst; pLst = Area.NextObjects(pLst, &pSct))
+		for (C4Object *obj : *pLst)
+			if (obj->Status && obj->pMeshInstance && !obj->pMeshInstance->GetAttachParent())
+				if (!obj->Contained && obj->IsVisible(iPlayer, false))
+					instances.push_back(obj->pMeshInstance);
+	// objects may be in several sectors
+	std::sort(instances.begin(), instances.end());
+	instances.erase(std::unique(instances.begin(), instances.end()), instances.end());
+	StdMeshInstance::UpdateBoneTransforms(instances);
+}
+
 void C4GameObjects::DeleteObjects(bool fDeleteInactive)
 {
 	C4ObjectList::DeleteObjects();
@@ -406,6 +424,8 @@ void C4GameObjects::FixObjectOrder()
 					DebugLogF("Objects.txt: Wrong object order of #%d-#%d! (down)", (int) pObj->Number, (int) pLnkPrev->Obj->Number);
 					pLastWarnObj = pLnkPrev->Obj;
 				}
+				// order keys stay with the list position
+				std::swap(pObj->MainListOrder, pLnkPrev->Obj->MainListOrder);
 				pLnk->Obj = pLnkPrev->Obj;
 				pLnkPrev->Obj = pObj;
 				pLnkLastUnsorted = pLnkPrev;
@@ -431,6 +451,8 @@ void C4GameObjects::FixObjectOrder()
 					DebugLogF("Objects.txt: Wrong object order of #%d-#%d! (up)", (int) pObj->Number, (int) pLnkPrev->Obj->Number);
 					pLastWarnObj = pLnkPrev->Obj;
 				}
+				// order keys stay with the list position
+				std::swap(pObj->MainListOrder, pLnkPrev->Obj->MainListOrder);
 				pLnk->Obj = pLnkPrev->Obj;
 				pLnkPrev->Obj = pObj;
 				pLnk1stUnsorted = pLnkPrev;
@@ -443,6 +465,19 @@ void C4GameObjects::FixObjectOrder()
 		pLnk0 = pLnk1stUnsorted;
 	}
 	// objects fixed!
+	assert(CheckOrderKeys());
+}
+
+bool C4GameObjects::CheckOrderKeys()
+{
+	// order keys must increase along the main list
+	for (C4ObjectLink *pLnk = First; pLnk && pLnk->Next; pLnk = pLnk->Next)
+		if (pLnk->Obj->MainListOrder >= pLnk->Next->Obj->MainListOrder)
+		{
+			LogF("CheckOrderKeys failure: #%d before #%d", (int) pLnk->Obj->Number, (int) pLnk->Next->Obj->Number);
+			return false;
+		}
+	return true;
 }
 
 void C4GameObjects::ResortUnsorted()
@@ -537,3 +572,51 @@ uint32_t C4GameObjects::GetNextMarker()
 	}
 	return marker;
 }
+
+void C4GameObjects::InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore)
+{
+	C4NotifyingObjectList::InsertLinkBefore(pLink, pBefore);
+	AssignOrderKey(pLink);
+}
+
+void C4GameObjects::InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter)
+{
+	C4NotifyingObjectList::InsertLink(pLink, pAfter);
+	AssignOrderKey(pLink);
+}
+
+void C4GameObjects::AssignOrderKey(C4ObjectLink *pLnk)
+{
+	// keys 0 and UINT64_MAX are never used, so they can serve as bounds at the list ends
+	uint64_t iLow = pLnk->Prev ? pLnk->Prev->Obj->MainListOrder : 0;
+	uint64_t iHigh = pLnk->Next ? pLnk->Next->Obj->MainListOrder : UINT64_MAX;
+	assert(iHigh > iLow);
+	if (iHigh - iLow > 1)
+	{
+		pLnk->Obj->MainListOrder = iLow + (iHigh - iLow) / 2;
+		return;
+	}
+	// no free key: grow a window around the link until its key range is sparse enough
+	// (or it covers the whole list) and spread the keys of the window evenly
+	C4ObjectLink *pFirst = pLnk, *pLast = pLnk;
+	uint64_t iCount = 1;
+	for (;;)
+	{
+		for (uint64_t i = iCount; i; --i)
+		{
+			if (pFirst->Prev) { pFirst = pFirst->Prev; ++iCount; }
+			if (pLast->Next) { pLast = pLast->Next; ++iCount; }
+		}
+		iLow = pFirst->Prev ? pFirst->Prev->Obj->MainListOrder : 0;
+		iHigh = pLast->Next ? pLast->Next->Obj->MainListOrder : UINT64_MAX;
+		if ((iHigh - iLow) / (iCount + 1) > iCount) break;
+		if (!pFirst->Prev && !pLast->Next) break;
+	}
+	uint64_t iStep = (iHigh - iLow) / (iCount + 1);
+	for (C4ObjectLink *pCur = pFirst; ; pCur = pCur->Next)
+	{
+		iLow += iStep;
+		pCur->Obj->MainListOrder = iLow;
+		if (pCur == pLast) break;
+	}
+}
@@ -53,6 +53,7 @@ public:
 	C4Object *AtObject(int ctx, int cty, DWORD &ocf, C4Object *exclude=NULL); // find object at ctx/cty
 	void Synchronize(); // network synchronization
 	void UpdateSolidMasks();
+	void UpdateMeshPoses(const C4Rect &rect, int32_t iPlayer); // compute bone transforms of meshes drawn in rect at once
 
 	C4Object *ObjectPointer(int32_t iNumber); // object pointer by number
 	C4Object* SafeObjectPointer(int32_t iNumber);
@@ -67,6 +68,7 @@ public:
 	void UpdatePosResort(C4Object *pObj);
 
 	void FixObjectOrder(); // Called after loading: Resort any objects that are out of order
+	bool CheckOrderKeys(); // check that MainListOrder increases along the main list
 	void ResortUnsorted(); // resort any objects with unsorted-flag set into lists
 
 	void DeleteObjects(bool fDeleteInactive); // delete all objects and links
@@ -80,6 +82,12 @@ public:
 	void SetOCF();
 
 	uint32_t GetNextMarker(); // Get a new marker. If all markers are exceeded (LastUsedMarker is 0xffffffff), restart marker at 1 and reset all object markers to zero.
+
+protected:
+	virtual void InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore);
+	virtual void InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter);
+	virtual bool HasOrderKeys() const { return true; }
+	void AssignOrderKey(C4ObjectLink *pLnk); // give the object a MainListOrder between its neighbours, relabeling nearby objects if necessary
 };
 
 extern C4GameObjects Objects;
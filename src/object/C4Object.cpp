@@ -188,6 +188,7 @@ void C4Object::Default()
 	xdir=ydir=rdir=0;
 	Mobile=0;
 	Unsorted=false;
+	MainListOrder=0;
 	Initializing=false;
 	OnFire=0;
 	InLiquid=0;
@@ -220,6 +221,7 @@ void C4Object::Default()
 	pMeshInstance=NULL;
 	pDrawTransform=NULL;
 	pEffects=NULL;
+	EffectClock=C4EffectClock();
 	pGfxOverlay=NULL;
 	iLastAttachMovementFrame=-1;
 
@@ -953,7 +955,7 @@ void C4Object::UpdateOCF()
 bool C4Object::ExecLife()
 {
 	// Breathing
-	if (!::Game.iTick5)
+	if (::Game.IsObjectTick(5, Number))
 		if (Alive && !Def->NoBreath)
 		{
 			// Supply check
@@ -983,7 +985,7 @@ bool C4Object::ExecLife()
 		}
 
 	// Corrosion energy loss
-	if (!::Game.iTick10)
+	if (::Game.IsObjectTick(10, Number))
 		if (Alive)
 			if (InMat!=MNone)
 				if (::MaterialMap.Map[InMat].Corrosive)
@@ -991,7 +993,7 @@ bool C4Object::ExecLife()
 						DoEnergy(-::MaterialMap.Map[InMat].Corrosive/15,false,C4FxCall_EngCorrosion, NO_OWNER);
 
 	// InMat incineration
-	if (!::Game.iTick10)
+	if (::Game.IsObjectTick(10, Number))
 		if (InMat!=MNone)
 			if (::MaterialMap.Map[InMat].Incindiary)
 				if (GetPropertyInt(P_ContactIncinerate) > 0)
@@ -1004,7 +1006,7 @@ bool C4Object::ExecLife()
 				}
 
 	// birthday
-	if (!::Game.iTick255)
+	if (::Game.IsObjectTick(255, Number))
 		if (Alive)
 			if (Info)
 			{
@@ -1506,7 +1508,7 @@ bool C4Object::Push(C4Real txdir, C4Real dforce, bool fStraighten)
 	if (!!xdir || !!ydir || !!rdir) Mobile=1;
 
 	// Stuck check
-	if (!::Game.iTick35) if (txdir) if (!Def->NoHorizontalMove)
+	if (::Game.IsObjectTick(35, Number)) if (txdir) if (!Def->NoHorizontalMove)
 				if (ContactCheck(GetX(), GetY())) // Resets t_contact
 				{
 					GameMsgObjectError(FormatString(LoadResStr("IDS_OBJ_STUCK"),GetName()).getData(),this);
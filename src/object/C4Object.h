@@ -28,6 +28,7 @@
 #include "C4Particles.h"
 #include "C4PropList.h"
 #include "C4ObjectPtr.h"
+#include "C4Effect.h"
 #include "StdMesh.h"
 
 /* Object status */
@@ -144,6 +145,7 @@ public:
 	int32_t iLastAttachMovementFrame; // last frame in which Attach-movement by a SolidMask was done
 	bool Mobile;
 	bool Unsorted; // NoSave //
+	uint64_t MainListOrder; // NoSave // position key in the main object list, see C4GameObjects::AssignOrderKey
 	bool Initializing; // NoSave //
 	bool InLiquid;
 	bool EntranceStatus;
@@ -172,6 +174,7 @@ public:
 	C4DefGraphics *pGraphics; // currently set object graphics
 	StdMeshInstance* pMeshInstance; // Instance for mesh-type objects
 	C4Effect *pEffects; // linked list of effects
+	C4EffectClock EffectClock; // execution clock of effect list
 	// particle lists that are bound to this object (either in front of behind it)
 	C4ParticleList *FrontParticles, *BackParticles;
 	void ClearParticleLists();
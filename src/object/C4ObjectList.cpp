@@ -29,6 +29,40 @@
 
 static const C4ObjectLink NULL_LINK = { NULL, NULL, NULL };
 
+C4ObjectLink *C4ObjectLink::FreeLinks = NULL;
+C4ObjectLink::PoolStats C4ObjectLink::Stats = { 0, 0, 0, 0 };
+
+void *C4ObjectLink::operator new(size_t iSize)
+{
+	if (iSize != sizeof(C4ObjectLink)) return ::operator new(iSize);
+	if (!FreeLinks)
+	{
+		// pool is empty: chain a new block of links into it
+		// blocks are never returned, so the pool stays at the peak number of links
+		C4ObjectLink *pBlock = static_cast<C4ObjectLink *>(::operator new(sizeof(C4ObjectLink) * BlockSize));
+		for (size_t i = 0; i < BlockSize; ++i)
+		{
+			pBlock[i].Next = FreeLinks;
+			FreeLinks = &pBlock[i];
+		}
+		Stats.Pooled += BlockSize;
+	}
+	C4ObjectLink *pLnk = FreeLinks;
+	FreeLinks = pLnk->Next;
+	++Stats.Allocations; ++Stats.InUse;
+	return pLnk;
+}
+
+void C4ObjectLink::operator delete(void *pMem, size_t iSize)
+{
+	if (!pMem) return;
+	if (iSize != sizeof(C4ObjectLink)) { ::operator delete(pMem); return; }
+	C4ObjectLink *pLnk = static_cast<C4ObjectLink *>(pMem);
+	pLnk->Next = FreeLinks;
+	FreeLinks = pLnk;
+	++Stats.Frees; --Stats.InUse;
+}
+
 C4ObjectList::C4ObjectList(): FirstIter(0)
 {
 	Default();
@@ -160,8 +194,19 @@ bool C4ObjectList::Add(C4Object *nObj, SortType eSort, C4ObjectList *pLstSorted)
 		bool fUnsorted = nObj->Unsorted;
 		if (!fUnsorted)
 		{
+			// Sort by master list with order keys? Only this list needs to be walked then.
+			if (pLstSorted && pLstSorted->HasOrderKeys())
+			{
+				for (cPrev=NULL,cLnk=First; cLnk; cLnk=cLnk->Next)
+					if (cLnk->Obj->Status && !cLnk->Obj->Unsorted)
+					{
+						if (cLnk->Obj->MainListOrder > nObj->MainListOrder)
+							break;
+						cPrev=cLnk;
+					}
+			}
 			// Sort by master list?
-			if (pLstSorted)
+			else if (pLstSorted)
 			{
 				cPrev = NULL; cLnk = First;
 				while(cLnk && (!cLnk->Obj->Status || cLnk->Obj->Unsorted)) cLnk = cLnk->Next;
@@ -27,6 +27,22 @@ class C4ObjectLink
 public:
 	C4Object *Obj;
 	C4ObjectLink *Prev,*Next;
+
+	// links are taken from a shared pool instead of the heap, because lists change all the time
+	static void *operator new(size_t iSize);
+	static void operator delete(void *pMem, size_t iSize);
+
+	struct PoolStats
+	{
+		uint32_t Allocations, Frees; // total link allocations/frees
+		uint32_t InUse, Pooled; // links currently allocated/owned by the pool
+	};
+	static const PoolStats &GetPoolStats() { return Stats; }
+
+private:
+	static const size_t BlockSize = 256; // links allocated at once when the pool runs dry
+	static C4ObjectLink *FreeLinks; // unused links, chained by Next
+	static PoolStats Stats;
 };
 
 class C4ObjectListChangeListener
@@ -162,6 +178,7 @@ protected:
 	virtual void InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore);
 	virtual void InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter);
 	virtual void RemoveLink(C4ObjectLink *pLnk);
+	virtual bool HasOrderKeys() const { return false; } // whether C4Object::MainListOrder reflects the order of this list
 	mutable iterator * FirstIter;
 	iterator * AddIter(iterator * iter) const;
 	void RemoveIter(iterator * iter) const;
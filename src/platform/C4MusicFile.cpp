@@ -175,7 +175,8 @@ void C4MusicFileSDL::SetVolume(int iLevel)
 
 C4MusicFileOgg::C4MusicFileOgg() :
 	playing(false), streaming_done(false), loaded(false), channel(0), current_section(0), byte_pos_total(0), volume(1.0f),
-	is_loading_from_file(false), last_source_file_pos(0), last_playback_pos_sec(0), last_interruption_time()
+	is_loading_from_file(false), last_source_file_pos(0), last_playback_pos_sec(0), last_interruption_time(),
+	decoder(this), block_consumed(false), block_decoded(false), ring_first(0), ring_count(0), decoding_done(false)
 {
 	for (size_t i=0; i<num_buffers; ++i)
 		buffers[i] = 0;
@@ -189,6 +190,8 @@ C4MusicFileOgg::~C4MusicFileOgg()
 
 void C4MusicFileOgg::Clear()
 {
+	// the decoder must not touch the file anymore
+	StopDecoder();
 	// clear ogg file
 	if (loaded)
 	{
@@ -375,13 +378,22 @@ bool C4MusicFileOgg::Play(bool loop, double max_resume_time)
 	SetVolume(float(::Config.Sound.MusicVolume) / 100.0f);
 
 	// prepare read
-	ogg_info.sound_data.resize(num_buffers * buffer_size);
+	ogg_info.sound_data.resize(num_blocks * buffer_size);
 	alGenBuffers(num_buffers, buffers);
+	free_buffers.assign(buffers, buffers + num_buffers);
 	ov_time_seek(&ogg_file, last_playback_pos_sec);
 
-	// Fill initial buffers
-	for (size_t i=0; i<num_buffers; ++i)
-		if (!FillBuffer(i)) break; // if this fails, the piece is shorter than the initial buffers
+	// Start decoding and fill all buffers before playing, because Execute only polls occasionally
+	StartDecoder();
+	for (;;)
+	{
+		{
+			CStdLock lock(&ring_mutex);
+			if (decoding_done || ring_count >= num_buffers) break;
+		}
+		block_decoded.WaitFor(INFINITE);
+	}
+	QueueBlocks();
 
 	// play!
 	alErrorCheck(alSourcePlay(channel));
@@ -389,6 +401,25 @@ bool C4MusicFileOgg::Play(bool loop, double max_resume_time)
 	return true;
 }
 
+void C4MusicFileOgg::StartDecoder()
+{
+	ring_first = ring_count = 0;
+	decoding_done = false;
+	byte_pos_total = 0;
+	block_consumed.Reset();
+	block_decoded.Reset();
+	decoder.Start();
+}
+
+void C4MusicFileOgg::StopDecoder()
+{
+	if (!decoder.IsStarted()) return;
+	// wake the decoder if it is waiting for a free block
+	decoder.SignalStop();
+	block_consumed.Set();
+	decoder.Stop();
+}
+
 double C4MusicFileOgg::GetRemainingTime()
 {
 	// Note: Only valid after piece has been stopped
@@ -397,6 +428,8 @@ double C4MusicFileOgg::GetRemainingTime()
 
 void C4MusicFileOgg::Stop(int fadeout_ms)
 {
+	StopDecoder();
+	free_buffers.clear();
 	if (playing)
 	{
 		// remember position for eventual later resume
@@ -448,51 +481,89 @@ bool C4MusicFileOgg::HasCategory(const char *szcat) const
 	return false;
 }
 
-bool C4MusicFileOgg::FillBuffer(size_t idx)
+void C4MusicFileOgg::DecodeBlock()
 {
-	// uncompress from ogg data
-	int endian = 0;
-	long bytes_read_total = 0, bytes_read;
-	char uncompressed_data[buffer_size];
-	do {
-		bytes_read = ov_read(&ogg_file, uncompressed_data+bytes_read_total, (buffer_size-bytes_read_total)*sizeof(BYTE), endian, 2, 1, &current_section);
-		bytes_read_total += bytes_read;
-	} while (bytes_read > 0 && bytes_read_total < buffer_size);
-	// buffer data
-	if (bytes_read_total)
+	// find a free block in the ring
+	size_t slot;
 	{
-		byte_pos_total += bytes_read_total;
-		ALuint buffer = buffers[idx];
-		alErrorCheck(alBufferData(buffer, ogg_info.format, uncompressed_data, bytes_read_total, ogg_info.sample_rate));
-		// queue buffer
-		alErrorCheck(alSourceQueueBuffers(channel, 1, &buffer));
+		CStdLock lock(&ring_mutex);
+		if (decoding_done || ring_count == num_blocks)
+		{
+			lock.Clear();
+			block_consumed.WaitFor(INFINITE);
+			return;
+		}
+		slot = (ring_first + ring_count) % num_blocks;
 	}
-	// streaming done?
-	if (bytes_read_total < buffer_size)
+	// uncompress from ogg data. The block is not visible to the main thread until it is published below.
+	char *uncompressed_data = reinterpret_cast<char *>(&ogg_info.sound_data[slot * buffer_size]);
+	int endian = 0;
+	long bytes_read_total, bytes_read;
+	bool done = false;
+	for (;;)
 	{
+		bytes_read_total = 0;
+		do {
+			bytes_read = ov_read(&ogg_file, uncompressed_data+bytes_read_total, (buffer_size-bytes_read_total)*sizeof(BYTE), endian, 2, 1, &current_section);
+			if (bytes_read > 0) bytes_read_total += bytes_read;
+		} while (bytes_read > 0 && bytes_read_total < buffer_size);
+		byte_pos_total += bytes_read_total;
+		// might have more data to stream
+		if (bytes_read_total == buffer_size) break;
 		// streaming done. loop or done.
-		if (loop)
+		if (!loop)
 		{
-			// reset pos in ogg file
-			ov_raw_seek(&ogg_file, 0);
-			// if looping and nothing has been committed to this buffer yet, try again
-			// except if byte_pos_total==0, i.e. if the piece is completely empty
-			size_t prev_bytes_total = byte_pos_total;
-			byte_pos_total = 0;
-			if (!bytes_read_total && prev_bytes_total) return FillBuffer(idx);
-			return true;
+			done = true;
+			break;
 		}
-		else
+		// reset pos in ogg file
+		ov_raw_seek(&ogg_file, 0);
+		// if looping and nothing has been committed to this block yet, try again
+		// except if byte_pos_total==0, i.e. if the piece is completely empty
+		size_t prev_bytes_total = byte_pos_total;
+		byte_pos_total = 0;
+		if (bytes_read_total || !prev_bytes_total) break;
+	}
+	// publish block
+	{
+		CStdLock lock(&ring_mutex);
+		if (bytes_read_total)
 		{
-			// non-looping: we're done.
-			return false;
+			block_sizes[slot] = bytes_read_total;
+			++ring_count;
 		}
+		if (done) decoding_done = true;
 	}
-	else
+	block_decoded.Set();
+}
+
+void C4MusicFileOgg::QueueBlocks()
+{
+	while (!free_buffers.empty())
 	{
-		// might have more data to stream
-		return true;
+		size_t slot;
+		{
+			CStdLock lock(&ring_mutex);
+			if (!ring_count) break;
+			slot = ring_first;
+		}
+		// buffer data
+		ALuint buffer = free_buffers.back();
+		free_buffers.pop_back();
+		alErrorCheck(alBufferData(buffer, ogg_info.format, &ogg_info.sound_data[slot * buffer_size], block_sizes[slot], ogg_info.sample_rate));
+		// queue buffer
+		alErrorCheck(alSourceQueueBuffers(channel, 1, &buffer));
+		// hand block back to the decoder
+		{
+			CStdLock lock(&ring_mutex);
+			ring_first = (ring_first + 1) % num_blocks;
+			--ring_count;
+		}
+		block_consumed.Set();
 	}
+	// streaming done?
+	CStdLock lock(&ring_mutex);
+	if (decoding_done && !ring_count) streaming_done = true;
 }
 
 void C4MusicFileOgg::Execute()
@@ -502,7 +573,6 @@ void C4MusicFileOgg::Execute()
 		// get processed buffer count
 		ALint num_processed = 0;
 		alErrorCheck(alGetSourcei(channel, AL_BUFFERS_PROCESSED, &num_processed));
-		bool done = false;
 		while (num_processed--)
 		{
 			// release processed buffer
@@ -516,12 +586,9 @@ void C4MusicFileOgg::Execute()
 			double buffer_secs = double(buffer_size) / buf_bits / buf_chans / buf_freq * 8;
 			last_playback_pos_sec += buffer_secs;
 			// refill processed buffer
-			size_t buffer_idx;
-			for (buffer_idx=0; buffer_idx<num_buffers; ++buffer_idx)
-				if (buffers[buffer_idx] == buffer) break;
-			if (!done) done = !FillBuffer(buffer_idx);
+			free_buffers.push_back(buffer);
 		}
-		if (done) streaming_done = true;
+		QueueBlocks();
 		// check if done
 		ALint state = 0;
 		alErrorCheck(alGetSourcei(channel, AL_SOURCE_STATE, &state));
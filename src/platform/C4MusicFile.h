@@ -20,6 +20,8 @@
 
 #include <C4SoundIncludes.h>
 #include <C4SoundLoaders.h>
+#include <StdScheduler.h>
+#include <StdSync.h>
 
 /* Base class */
 
@@ -104,7 +106,7 @@ public:
 	C4TimeMilliseconds GetLastInterruptionTime() const { return last_interruption_time; }
 	virtual StdStrBuf GetDebugInfo() const;
 private:
-	enum { num_buffers = 4, buffer_size = 160*1024 };
+	enum { num_buffers = 4, buffer_size = 160*1024, num_blocks = num_buffers + 2 };
 	::C4SoundLoaders::VorbisLoader::CompressedData data;
 	::C4SoundLoaders::SoundInfo ogg_info;
 	OggVorbis_File ogg_file;
@@ -121,8 +123,28 @@ private:
 	float volume;
 	std::vector<StdCopyStrBuf> categories; // cateogries stored in meta info
 
-	bool FillBuffer(size_t idx);
-	void Execute(); // fill processed buffers
+	// Decoding runs in its own thread while playing. It fills a ring of decoded blocks kept in ogg_info.sound_data,
+	// which the main thread hands to OpenAL as buffers become free.
+	class DecoderThread : public StdThread
+	{
+		C4MusicFileOgg *file;
+	protected:
+		virtual void Execute() { file->DecodeBlock(); }
+	public:
+		explicit DecoderThread(C4MusicFileOgg *file) : file(file) { }
+	} decoder;
+	CStdCSec ring_mutex;
+	CStdEvent block_consumed, block_decoded;
+	size_t block_sizes[num_blocks];
+	size_t ring_first, ring_count; // decoded blocks not yet queued
+	bool decoding_done; // decoder reached the end of a non-looping piece
+	std::vector<ALuint> free_buffers; // buffers not queued on the channel
+
+	void StartDecoder();
+	void StopDecoder();
+	void DecodeBlock(); // decoder thread: decode the next block into the ring
+	void QueueBlocks(); // queue decoded blocks into free buffers
+	void Execute(); // recycle processed buffers
 	void UnprepareSourceFileReading(); // close file handle but remember buffer position for re-opening
 	bool PrepareSourceFileReading(); // close file handle but remember buffer position for re-opening
 
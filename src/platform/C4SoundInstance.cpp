@@ -34,6 +34,7 @@ using namespace C4SoundLoaders;
 C4SoundEffect::C4SoundEffect():
 		Instances (0),
 		pSample (0),
+		SampleSize (0),
 		FirstInst (NULL),
 		Next (NULL)
 {
@@ -48,23 +49,39 @@ C4SoundEffect::~C4SoundEffect()
 void C4SoundEffect::Clear()
 {
 	while (FirstInst) RemoveInst(FirstInst);
+	Unload();
+}
+
+void C4SoundEffect::Unload()
+{
+	assert(!FirstInst);
 #if AUDIO_TK == AUDIO_TK_SDL_MIXER
 	if (pSample) Mix_FreeChunk(pSample);
 #elif AUDIO_TK == AUDIO_TK_OPENAL
 	if (pSample) alDeleteBuffers(1, &pSample);
 #endif
 	pSample = 0;
+	SampleSize = 0;
 }
 
 bool C4SoundEffect::Load(const char *szFileName, C4Group &hGroup, const char *namespace_prefix)
 {
 	// Sound check
 	if (!Config.Sound.RXSound) return false;
-	// Locate sound in file
-	StdBuf WaveBuffer;
-	if (!hGroup.LoadEntry(szFileName, &WaveBuffer)) return false;
-	// load it from mem
-	if (!Load((BYTE*)WaveBuffer.getMData(), WaveBuffer.getSize())) return false;
+	// Nothing could decode it anyway
+	if (!SoundLoader::first_loader) return false;
+	// Locate sound in file. Decoding is deferred until the sound is played, because most sounds never are.
+	if (!hGroup.LoadEntry(szFileName, &Data) || !Data.getSize()) return false;
+	// But reject files no loader recognizes right away
+	SoundLoader* loader;
+	for (loader = SoundLoader::first_loader; loader; loader = loader->next)
+		if (loader->Probe((BYTE*)Data.getMData(), Data.getSize()))
+			break;
+	if (!loader)
+	{
+		Data.Clear();
+		return false;
+	}
 	// Set name
 	if (namespace_prefix)
 	{
@@ -111,13 +128,31 @@ bool C4SoundEffect::Load(BYTE *pData, size_t iDataLen, bool fRaw)
 			}
 			SampleRate = info.sample_rate;
 			Length = info.sample_length*1000;
+#if AUDIO_TK == AUDIO_TK_SDL_MIXER
+			if (pSample) SampleSize = pSample->alen;
+#else
+			SampleSize = info.sound_data.size();
+#endif
 			break;
 		}
 	}
-	*Name = '\0';
 	return !!pSample;
 }
 
+bool C4SoundEffect::Decode()
+{
+	if (pSample) return true;
+	if (Data.isNull()) return false;
+	if (!Load((BYTE*)Data.getMData(), Data.getSize()))
+	{
+		// don't try again every time the sound is requested
+		DebugLogF("Warning: could not decode sound '%s'", Name);
+		Data.Clear();
+		return false;
+	}
+	return true;
+}
+
 void C4SoundEffect::Execute()
 {
 	// check for instances that have stopped and volume changes
@@ -136,6 +171,9 @@ C4SoundInstance *C4SoundEffect::New(bool fLoop, int32_t iVolume, C4Object *pObj,
 {
 	// check: too many instances?
 	if (!fLoop && Instances >= C4MaxSoundInstances) return NULL;
+	// decode on first use
+	if (!Decode()) return NULL;
+	tLastUsed = C4TimeMilliseconds::Now();
 	// create & init sound instance
 	C4SoundInstance *pInst = new C4SoundInstance();
 	if (!pInst->Create(this, fLoop, iVolume, pObj, 0, iCustomFalloffDistance, iPitch, modifier)) { delete pInst; return NULL; }
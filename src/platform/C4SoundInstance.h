@@ -35,12 +35,18 @@ public:
 	int32_t Instances;
 	int32_t SampleRate, Length;
 	C4SoundHandle pSample;
+	size_t SampleSize; // memory used by the decoded sample
+	StdBuf Data; // file contents; decoded into pSample when the sound is first played
+	C4TimeMilliseconds tLastUsed;
 	C4SoundInstance *FirstInst;
 	C4SoundEffect *Next;
 public:
 	void Clear();
 	bool Load(const char *szFileName, C4Group &hGroup, const char *namespace_prefix);
 	bool Load(BYTE *pData, size_t iDataLen, bool fRaw=false); // load directly from memory
+	bool Decode();
+	void Unload(); // frees the decoded sample; it is decoded again on demand
+	bool IsLoaded() const { return !!pSample; }
 	void Execute();
 	C4SoundInstance *New(bool fLoop = false, int32_t iVolume = 100, C4Object *pObj = NULL, int32_t iCustomFalloffDistance = 0, int32_t iPitch = 0, C4SoundModifier *modifier = NULL);
 	C4SoundInstance *GetInstance(C4Object *pObj);
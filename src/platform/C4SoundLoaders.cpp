@@ -100,6 +100,24 @@ bool AppleSoundLoader::ReadInfo(SoundInfo* result, BYTE* data, size_t data_lengt
 	return err == noErr;
 }
 
+bool AppleSoundLoader::Probe(BYTE* data, size_t data_length)
+{
+	CFDataRef data_container = CFDataCreateWithBytesNoCopy(kCFAllocatorDefault, data, data_length, kCFAllocatorNull);
+	AudioFileID sound_file;
+	OSStatus err = AudioFileOpenWithCallbacks((void*)data_container,
+		AudioToolBoxReadCallback,
+		NULL,
+		AudioToolBoxGetSizeProc,
+		NULL,
+		0,
+		&sound_file
+	);
+	if (err == noErr)
+		AudioFileClose(sound_file);
+	CFRelease(data_container);
+	return err == noErr;
+}
+
 AppleSoundLoader AppleSoundLoader::singleton;
 #endif
 
@@ -236,6 +254,22 @@ bool VorbisLoader::ReadInfo(SoundInfo* result, BYTE* data, size_t data_length, u
 	return true;
 }
 
+bool VorbisLoader::Probe(BYTE* data, size_t data_length)
+{
+	CompressedData compressed(data, data_length);
+	OggVorbis_File ogg_file;
+	memset(&ogg_file, 0, sizeof(ogg_file));
+	ov_callbacks callbacks;
+	callbacks.read_func  = &mem_read_func;
+	callbacks.seek_func = &mem_seek_func;
+	callbacks.close_func = &mem_close_func;
+	callbacks.tell_func = &mem_tell_func;
+	// only reads the headers
+	bool fOK = !ov_test_callbacks(&compressed, &ogg_file, NULL, 0, callbacks);
+	ov_clear(&ogg_file);
+	return fOK;
+}
+
 VorbisLoader VorbisLoader::singleton;
 
 #ifndef __APPLE__
@@ -274,6 +308,12 @@ bool WavLoader::ReadInfo(SoundInfo* result, BYTE* data, size_t data_length, uint
 	return true;
 }
 
+bool WavLoader::Probe(BYTE* data, size_t data_length)
+{
+	// RIFF WAVE header
+	return data_length >= 12 && !memcmp(data, "RIFF", 4) && !memcmp(data + 8, "WAVE", 4);
+}
+
 WavLoader WavLoader::singleton;
 #endif
 
@@ -298,6 +338,15 @@ bool SDLMixerSoundLoader::ReadInfo(SoundInfo* result, BYTE* data, size_t data_le
 	return true;
 }
 
+bool SDLMixerSoundLoader::Probe(BYTE* data, size_t data_length)
+{
+	// headers of the formats SDL_Mixer loads samples from
+	if (data_length < 12) return false;
+	return (!memcmp(data, "RIFF", 4) && !memcmp(data + 8, "WAVE", 4)) ||
+	       !memcmp(data, "OggS", 4) || !memcmp(data, "FORM", 4) ||
+	       (data_length >= 19 && !memcmp(data, "Creative Voice File", 19));
+}
+
 SDLMixerSoundLoader SDLMixerSoundLoader::singleton;
 
 #endif
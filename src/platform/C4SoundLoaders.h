@@ -50,6 +50,7 @@ namespace C4SoundLoaders
 		}
 		virtual ~SoundLoader() {}
 		virtual bool ReadInfo(SoundInfo* info, BYTE* data, size_t data_length, uint32_t options = 0) = 0;
+		virtual bool Probe(BYTE* data, size_t data_length) = 0; // check the header only, without decoding
 	};
 
 #if AUDIO_TK == AUDIO_TK_OPENAL && defined(__APPLE__)
@@ -58,6 +59,7 @@ namespace C4SoundLoaders
 	public:
 		AppleSoundLoader(): SoundLoader() {}
 		virtual bool ReadInfo(SoundInfo* result, BYTE* data, size_t data_length, uint32_t);
+		virtual bool Probe(BYTE* data, size_t data_length);
 	protected:
 		static AppleSoundLoader singleton;
 	};
@@ -94,6 +96,7 @@ namespace C4SoundLoaders
 		static long file_tell_func(void* datasource);
 	public:
 		virtual bool ReadInfo(SoundInfo* result, BYTE* data, size_t data_length, uint32_t);
+		virtual bool Probe(BYTE* data, size_t data_length);
 	protected:
 		static VorbisLoader singleton;
 	};
@@ -103,6 +106,7 @@ namespace C4SoundLoaders
 	{
 	public:
 		virtual bool ReadInfo(SoundInfo* result, BYTE* data, size_t data_length, uint32_t);
+		virtual bool Probe(BYTE* data, size_t data_length);
 	protected:
 		static WavLoader singleton;
 	};
@@ -114,6 +118,7 @@ namespace C4SoundLoaders
 	public:
 		static SDLMixerSoundLoader singleton;
 		virtual bool ReadInfo(SoundInfo* result, BYTE* data, size_t data_length, uint32_t);
+		virtual bool Probe(BYTE* data, size_t data_length);
 	};
 #endif
 }
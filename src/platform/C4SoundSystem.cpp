@@ -31,7 +31,7 @@
 #include <C4SoundLoaders.h>
 
 C4SoundSystem::C4SoundSystem():
-		FirstSound (NULL)
+		FirstSound (NULL), tLastUnload(C4TimeMilliseconds::Now())
 {
 }
 
@@ -79,6 +79,7 @@ void C4SoundSystem::ClearEffects()
 		delete csfx;
 	}
 	FirstSound=NULL;
+	EffectMatches.clear();
 }
 
 void C4SoundSystem::Execute()
@@ -92,39 +93,69 @@ void C4SoundSystem::Execute()
 		// Instance removal check
 		csfx->Execute();
 	}
+	// samples only pile up as sounds get played, so there's no need to count them every frame
+	if (C4TimeMilliseconds::Now() - tLastUnload >= C4SoundUnloadInterval)
+	{
+		UnloadSamples();
+		tLastUnload = C4TimeMilliseconds::Now();
+	}
 }
 
-C4SoundEffect* C4SoundSystem::GetEffect(const char *szSndName)
+void C4SoundSystem::UnloadSamples()
+{
+	size_t iMaxSize = size_t(std::max<int32_t>(Config.Sound.SampleCacheSize, 0)) * 1024 * 1024;
+	// Sum up decoded samples; effects that are currently playing can't be unloaded
+	size_t iSize = 0;
+	std::vector<C4SoundEffect *> Unloadable;
+	for (C4SoundEffect *csfx=FirstSound; csfx; csfx=csfx->Next)
+		if (csfx->IsLoaded())
+		{
+			iSize += csfx->SampleSize;
+			if (!csfx->FirstInst) Unloadable.push_back(csfx);
+		}
+	if (iSize <= iMaxSize) return;
+	// Free least recently used samples first
+	std::sort(Unloadable.begin(), Unloadable.end(), [](C4SoundEffect *a, C4SoundEffect *b) { return a->tLastUsed < b->tLastUsed; });
+	for (C4SoundEffect *csfx : Unloadable)
+	{
+		if (iSize <= iMaxSize) break;
+		iSize -= csfx->SampleSize;
+		csfx->Unload();
+	}
+}
+
+const std::vector<C4SoundEffect *> &C4SoundSystem::GetMatchingEffects(const char *szSndName)
 {
-	// Remember wildcards before adding .* extension - if there are 2 versions with different file extensions, play the last added
-	bool bRandomSound = SCharCount('?',szSndName) || SCharCount('*',szSndName);
 	// Evaluate sound name
 	char szName[C4MaxSoundName+2+1];
 	SCopy(szSndName,szName,C4MaxSoundName);
 	// Any extension accepted
 	DefaultExtension(szName,"*");
-	// Play nth Sound. Standard: 1
-	int32_t iNumber = 1;
-	// Sound with a wildcard: determine number of available matches
-	if (bRandomSound)
-	{
-		iNumber = 0;
-		// Count matching sounds
-		for (C4SoundEffect *pSfx=FirstSound; pSfx; pSfx=pSfx->Next)
-			if (WildcardMatch(szName,pSfx->Name))
-				++iNumber;
-		// Nothing found? Abort
-		if(iNumber == 0)
-			return NULL;
-		iNumber=SafeRandom(iNumber)+1;
-	}
-	// Find requested sound effect in bank
-	C4SoundEffect *pSfx;
-	for (pSfx=FirstSound; pSfx; pSfx=pSfx->Next)
+	// Matches are only searched once per name until the sound bank changes
+	auto iter = EffectMatches.find(szName);
+	if (iter != EffectMatches.end()) return iter->second;
+	std::vector<C4SoundEffect *> Matches;
+	for (C4SoundEffect *pSfx=FirstSound; pSfx; pSfx=pSfx->Next)
 		if (WildcardMatch(szName,pSfx->Name))
-			if(!--iNumber)
-				break;
-	return pSfx; // Is still NULL if nothing is found
+			Matches.push_back(pSfx);
+	// Names without matches can be anything a script comes up with, so they are not kept
+	static const std::vector<C4SoundEffect *> NoMatches;
+	if (Matches.empty()) return NoMatches;
+	if (EffectMatches.size() >= C4MaxSoundMatches) EffectMatches.clear();
+	return EffectMatches[szName] = std::move(Matches);
+}
+
+C4SoundEffect* C4SoundSystem::GetEffect(const char *szSndName)
+{
+	// Remember wildcards before adding .* extension - if there are 2 versions with different file extensions, play the last added
+	bool bRandomSound = SCharCount('?',szSndName) || SCharCount('*',szSndName);
+	const std::vector<C4SoundEffect *> &Matches = GetMatchingEffects(szSndName);
+	// Nothing found? Abort
+	if (Matches.empty()) return NULL;
+	// Sound with a wildcard: play a random match. Standard: the first one
+	if (bRandomSound)
+		return Matches[SafeRandom(int32_t(Matches.size()))];
+	return Matches.front();
 }
 
 C4SoundInstance *C4SoundSystem::NewEffect(const char *szSndName, bool fLoop, int32_t iVolume, C4Object *pObj, int32_t iCustomFalloffDistance, int32_t iPitch, C4SoundModifier *modifier)
@@ -145,17 +176,12 @@ C4SoundInstance *C4SoundSystem::NewEffect(const char *szSndName, bool fLoop, int
 
 C4SoundInstance *C4SoundSystem::FindInstance(const char *szSndName, C4Object *pObj)
 {
-	char szName[C4MaxSoundName+2+1];
-	// Evaluate sound name (see GetEffect)
-	SCopy(szSndName,szName,C4MaxSoundName);
-	DefaultExtension(szName,"*");
 	// Find an effect with a matching instance
-	for (C4SoundEffect *csfx = FirstSound; csfx; csfx = csfx->Next)
-		if (WildcardMatch(szName, csfx->Name))
-		{
-			C4SoundInstance *pInst = csfx->GetInstance(pObj);
-			if (pInst) return pInst;
-		}
+	for (C4SoundEffect *csfx : GetMatchingEffects(szSndName))
+	{
+		C4SoundInstance *pInst = csfx->GetInstance(pObj);
+		if (pInst) return pInst;
+	}
 	return NULL;
 }
 
@@ -190,6 +216,7 @@ int32_t C4SoundSystem::LoadEffects(C4Group &hGroup, const char *namespace_prefix
 					// Add effect
 					nsfx->Next=FirstSound;
 					FirstSound=nsfx;
+					EffectMatches.clear();
 					iNum++;
 				}
 				else
@@ -234,6 +261,7 @@ int32_t C4SoundSystem::RemoveEffect(const char *szFilename)
 			delete pSfx;
 			if (pPrev) pPrev->Next=pNext;
 			else FirstSound=pNext;
+			EffectMatches.clear();
 			iResult++;
 		}
 		else
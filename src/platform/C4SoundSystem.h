@@ -22,6 +22,9 @@
 
 #include <C4Group.h>
 #include <C4SoundModifiers.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 const int32_t
 	C4MaxSoundName=100,
@@ -30,6 +33,8 @@ const int32_t
 	C4AudibilityRadius=700;
 
 const int32_t SoundUnloadTime=60, SoundMaxUnloadSize=100000;
+const int32_t C4SoundUnloadInterval=1000; // ms between checks for decoded samples to free
+const size_t C4MaxSoundMatches=1024; // sound name patterns remembered before the match cache is reset
 
 class C4SoundInstance;
 class C4SoundEffect;
@@ -53,9 +58,15 @@ public:
 	C4SoundModifierList Modifiers;
 protected:
 	C4Group SoundFile;
-	C4SoundEffect *FirstSound; // TODO: Add a hash map for sound lookup. Also add a global list for all running sound instances.
+	C4SoundEffect *FirstSound; // TODO: Add a global list for all running sound instances.
+	// effects matching a sound name pattern (with default extension), in bank order. Only patterns with matches
+	// are kept. Reset whenever the bank changes.
+	std::unordered_map<std::string, std::vector<C4SoundEffect *> > EffectMatches;
+	C4TimeMilliseconds tLastUnload;
 	void ClearEffects();
+	const std::vector<C4SoundEffect *> &GetMatchingEffects(const char *szSound);
 	C4SoundEffect* GetEffect(const char *szSound);
+	void UnloadSamples(); // free decoded samples of unused effects beyond the configured cache size
 	int32_t RemoveEffect(const char *szFilename);
 };
 
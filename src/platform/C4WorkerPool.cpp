@@ -0,0 +1,86 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2015, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4WorkerPool.h"
+
+C4WorkerPool::C4WorkerPool():
+	pJob(NULL), iJobSize(0), iNextIndex(0), iGeneration(0), iBusyWorkers(0), fStopping(false)
+{
+}
+
+C4WorkerPool::~C4WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		fStopping = true;
+	}
+	JobReady.notify_all();
+	for (std::thread &Worker : Workers)
+		Worker.join();
+}
+
+unsigned int C4WorkerPool::GetThreadCount()
+{
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void C4WorkerPool::ParallelFor(size_t iCount, const std::function<void(size_t)> &Job)
+{
+	if (Workers.empty())
+		for (unsigned int i = 1; i < GetThreadCount(); ++i)
+			Workers.push_back(std::thread(&C4WorkerPool::RunWorker, this, iGeneration));
+	if (Workers.empty() || iCount < 2)
+	{
+		for (size_t i = 0; i < iCount; ++i)
+			Job(i);
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		pJob = &Job;
+		iJobSize = iCount;
+		iNextIndex = 0;
+		iBusyWorkers = Workers.size();
+		++iGeneration;
+	}
+	JobReady.notify_all();
+	RunJob();
+	std::unique_lock<std::mutex> Lock(Mutex);
+	JobDone.wait(Lock, [this]() { return !iBusyWorkers; });
+	pJob = NULL;
+}
+
+void C4WorkerPool::RunJob()
+{
+	for (size_t i = iNextIndex++; i < iJobSize; i = iNextIndex++)
+		(*pJob)(i);
+}
+
+void C4WorkerPool::RunWorker(unsigned int iDone)
+{
+	std::unique_lock<std::mutex> Lock(Mutex);
+	while (true)
+	{
+		JobReady.wait(Lock, [this, iDone]() { return fStopping || iGeneration != iDone; });
+		if (fStopping) return;
+		iDone = iGeneration;
+		Lock.unlock();
+		RunJob();
+		Lock.lock();
+		if (!--iBusyWorkers)
+			JobDone.notify_one();
+	}
+}
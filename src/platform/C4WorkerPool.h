@@ -0,0 +1,61 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2015, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+#ifndef INC_C4WorkerPool
+#define INC_C4WorkerPool
+
+/* Threads that stay around to run loops in parallel.
+
+   Starting threads costs more than many per-frame jobs take, so a pool
+   starts its workers on first use and keeps them waiting for the next
+   loop. Each loop index is handed out once; the calling thread works
+   along and ParallelFor returns when all indices are done.
+
+   A pool runs one loop at a time: it is meant to be owned by the single
+   thread that uses it. */
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class C4WorkerPool
+{
+public:
+	C4WorkerPool();
+	~C4WorkerPool();
+
+	// number of threads a loop is spread over, including the calling thread
+	static unsigned int GetThreadCount();
+	// call Job(i) for every i below iCount
+	void ParallelFor(size_t iCount, const std::function<void(size_t)> &Job);
+
+private:
+	std::vector<std::thread> Workers;
+	std::mutex Mutex;
+	std::condition_variable JobReady, JobDone;
+	const std::function<void(size_t)> *pJob;
+	size_t iJobSize;
+	std::atomic<size_t> iNextIndex;
+	unsigned int iGeneration; // counts loops so that waiting workers notice a new one
+	unsigned int iBusyWorkers;
+	bool fStopping;
+
+	void RunJob();
+	void RunWorker(unsigned int iDone); // iDone: the last loop started before the worker
+};
+
+#endif
@@ -40,6 +40,11 @@
 #include <fcntl.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
 #include <zlib.h>
 #include <string>
 
@@ -502,6 +507,16 @@ int FileTime(const char *szFilename)
 #endif
 }
 
+bool TouchFile(const char *szFilename)
+{
+	// set modification time to now
+#ifdef _WIN32
+	return !_wutime(GetWideChar(szFilename), NULL);
+#else
+	return !utime(szFilename, NULL);
+#endif
+}
+
 bool EraseFile(const char *szFilename)
 {
 #ifdef _WIN32
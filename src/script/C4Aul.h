@@ -22,6 +22,7 @@
 #include <C4Script.h>
 #include <C4StringTable.h>
 #include "C4AulFunc.h"
+#include "C4AulCodeCache.h"
 #include <string>
 #include <vector>
 
@@ -366,11 +367,16 @@ public:
 	C4ValueMapNames GlobalConstNames;
 	C4ValueMapData GlobalConsts;
 
+	// byte code generated by earlier links, kept by Clear
+	C4AulCodeCache CodeCache;
+
 	C4AulScriptEngine(); // constructor
 	~C4AulScriptEngine(); // destructor
 	void Clear(); // clear data
 	void Link(C4DefList *rDefs); // link and parse all scripts
 	void ReLink(C4DefList *rDefs); // unlink + relink and parse all scripts
+	void Tokenize(); // split all scripts into tokens for the parser
+	void ClearTokens(); // free the tokens again
 	virtual C4PropListStatic * GetPropList();
 	using C4AulScript::ReloadScript;
 	bool ReloadScript(const char *szScript, C4DefList *pDefs, const char *szLanguage); // search script and reload + relink, if found
@@ -0,0 +1,181 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2015, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Byte code of script functions, kept across links and game starts */
+
+#include <C4Include.h>
+#include <C4AulCodeCache.h>
+
+#include <C4Aul.h>
+#include <C4Version.h>
+#include <SHA1.h>
+
+// entries not used by this many saves are dropped
+const int32_t C4AulCodeCacheMaxAge = 8;
+
+// different code kept for the same text
+const size_t C4AulCodeCacheMaxVariants = 4;
+
+// bump when the meaning of the stored code changes without a new engine revision
+const int32_t C4AulCodeCacheFormat = 1;
+
+void C4AulCodeCache::Key::CompileFunc(StdCompiler *pComp)
+{
+	for (int i = 0; i < 5; ++i)
+		pComp->Value(Digest[i]);
+}
+
+void C4AulCodeCache::Lookup::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(Kind, "Kind"));
+	pComp->Value(mkNamingAdapt(Name, "Name"));
+	pComp->Value(mkNamingAdapt(Result, "Result"));
+	pComp->Value(mkNamingAdapt(Value, "Value"));
+	pComp->Value(mkNamingAdapt(Text, "Text"));
+}
+
+void C4AulCodeCache::Chunk::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(Type, "Type"));
+	pComp->Value(mkNamingAdapt(Par, "Par"));
+	pComp->Value(mkNamingAdapt(Pos, "Pos"));
+}
+
+void C4AulCodeCache::Entry::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(Length, "Length"));
+	pComp->Value(mkNamingAdapt(ParCount, "ParCount"));
+	pComp->Value(mkNamingAdapt(VarCount, "VarCount"));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(Lookups), "Lookups"));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(Strings), "Strings"));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(Code), "Code"));
+}
+
+void C4AulCodeCache::Variants::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(Entries), "Entries"));
+	pComp->Value(mkNamingAdapt(LastUse, "LastUse"));
+}
+
+C4AulCodeCache::Key C4AulCodeCache::GetKey(const char *szText, size_t iLength)
+{
+	sha1 ctx;
+	ctx.process_bytes(szText, iLength);
+	Key key;
+	ctx.get_digest(key.Digest);
+	return key;
+}
+
+const std::vector<C4AulCodeCache::Entry> *C4AulCodeCache::Find(const Key &key)
+{
+	auto i = Entries.find(key);
+	if (i == Entries.end()) return NULL;
+	// keep entries in use
+	if (i->second.LastUse != Session)
+	{
+		i->second.LastUse = Session;
+		Dirty = true;
+	}
+	return &i->second.Entries;
+}
+
+void C4AulCodeCache::Store(const Key &key, const Entry &entry)
+{
+	Variants &stored = Entries[key];
+	if (stored.Entries.size() >= C4AulCodeCacheMaxVariants)
+		stored.Entries.erase(stored.Entries.begin());
+	stored.Entries.push_back(entry);
+	stored.LastUse = Session;
+	Dirty = true;
+}
+
+void C4AulCodeCache::Clear()
+{
+	Entries.clear();
+	Filename.Clear();
+	Session = 0;
+	Dirty = false;
+}
+
+bool C4AulCodeCache::Load(const char *szFilename)
+{
+	// already loaded?
+	if (Filename && SEqual(Filename.getData(), szFilename)) return true;
+	Clear();
+	Filename.Copy(szFilename);
+	StdBuf Buf;
+	if (!Buf.LoadFromFile(szFilename)) return false;
+	try
+	{
+		CompileFromBuf<StdCompilerBinRead>(*this, Buf);
+	}
+	catch (StdCompiler::Exception *pExc)
+	{
+		// outdated or damaged: start over
+		delete pExc;
+		Entries.clear();
+		Session = 0;
+		return false;
+	}
+	return true;
+}
+
+bool C4AulCodeCache::Save()
+{
+	if (!Filename || !Dirty) return true;
+	// drop code of functions that no longer exist
+	for (auto i = Entries.begin(); i != Entries.end(); )
+		if (Session - i->second.LastUse > C4AulCodeCacheMaxAge)
+			i = Entries.erase(i);
+		else
+			++i;
+	++Session;
+	Dirty = false;
+	StdBuf Buf = DecompileToBuf<StdCompilerBinWrite>(*this);
+	return Buf.SaveToFile(Filename.getData());
+}
+
+void C4AulCodeCache::CompileFunc(StdCompiler *pComp)
+{
+	// code is only valid for the engine build that generated it
+	StdCopyStrBuf Version(FormatString("%s %s %d %d", C4VERSION, C4REVISION, C4AulCodeCacheFormat, (int) AB_EOFN));
+	StdCopyStrBuf FileVersion(Version);
+	pComp->Value(mkNamingAdapt(FileVersion, "Version"));
+	if (pComp->isCompiler() && FileVersion != Version)
+		pComp->excCorrupt("script code cache of another engine version");
+	pComp->Value(mkNamingAdapt(Session, "Session"));
+	int32_t iCount = Entries.size();
+	pComp->Value(mkNamingCountAdapt(iCount, "Entry"));
+	if (pComp->isCompiler())
+	{
+		Entries.clear();
+		for (int32_t i = 0; i < iCount; ++i)
+		{
+			Key key; Variants entry;
+			pComp->Value(mkNamingAdapt(key, "Key"));
+			pComp->Value(mkNamingAdapt(entry, "Entry"));
+			Entries[key] = std::move(entry);
+		}
+	}
+	else
+	{
+		for (auto &i : Entries)
+		{
+			Key key = i.first;
+			pComp->Value(mkNamingAdapt(key, "Key"));
+			pComp->Value(mkNamingAdapt(i.second, "Entry"));
+		}
+	}
+}
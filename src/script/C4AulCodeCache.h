@@ -0,0 +1,110 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2015, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Byte code of script functions, kept across links and game starts */
+
+#ifndef INC_C4AulCodeCache
+#define INC_C4AulCodeCache
+
+#include <unordered_map>
+#include <vector>
+
+// The parser stores the byte code of each function it generates here, keyed by a hash of the
+// function text. Code never holds pointers: strings are stored by value, and functions, global
+// variables and constants by the name the parser looked up. Before reusing an entry, the parser
+// repeats all of its lookups and takes the code only if every name still resolves the same way.
+class C4AulCodeCache
+{
+public:
+	// hash of a function text
+	struct Key
+	{
+		uint32_t Digest[5];
+		bool operator == (const Key &k) const { return !memcmp(Digest, k.Digest, sizeof(Digest)); }
+		void CompileFunc(StdCompiler *pComp);
+	};
+	struct KeyHash { size_t operator () (const Key &k) const { return k.Digest[0]; } };
+
+	// names the parser looks up in the script engine
+	enum LookupKind
+	{
+		LK_Local,     // local variable of the script
+		LK_Func,      // function called by name
+		LK_Inherited, // overloaded function called by inherited
+		LK_GlobalVar, // static variable
+		LK_Const,     // static const
+		LK_Call       // functions called with ->, for warnings only
+	};
+	// a lookup and its outcome
+	struct Lookup
+	{
+		int32_t Kind; // LookupKind
+		StdCopyStrBuf Name;
+		int32_t Result; // 0 if not found, else kind-specific: parameter count + 1, value type + 1...
+		int32_t Value; // int and bool constants; signature of functions
+		StdCopyStrBuf Text; // string constants
+		Lookup(): Kind(LK_Local), Result(0), Value(0) { }
+		bool operator == (const Lookup &l) const { return Kind == l.Kind && Result == l.Result && Value == l.Value && Text == l.Text; }
+		void CompileFunc(StdCompiler *pComp);
+	};
+	// a byte code chunk
+	struct Chunk
+	{
+		int32_t Type; // C4AulBCCType
+		int32_t Par; // int parameter, or index into Strings or Lookups for pointers
+		int32_t Pos; // source position relative to the function start
+		void CompileFunc(StdCompiler *pComp);
+	};
+	struct Entry
+	{
+		int32_t Length; // length of the function text
+		int32_t ParCount, VarCount;
+		std::vector<Lookup> Lookups;
+		std::vector<StdCopyStrBuf> Strings;
+		std::vector<Chunk> Code;
+		Entry(): Length(0), ParCount(0), VarCount(0) { }
+		void CompileFunc(StdCompiler *pComp);
+	};
+	// code of the same text generated for different scripts
+	struct Variants
+	{
+		std::vector<Entry> Entries;
+		int32_t LastUse; // number of the save that last used this text
+		Variants(): LastUse(0) { }
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	C4AulCodeCache(): Hits(0), Misses(0), Session(0), Dirty(false) { }
+
+	static Key GetKey(const char *szText, size_t iLength);
+	const std::vector<Entry> *Find(const Key &key); // get code for a function text, or NULL
+	void Store(const Key &key, const Entry &entry); // add code, forgetting the oldest variant if there are too many
+	void CountHit(bool fHit) { ++(fHit ? Hits : Misses); }
+
+	void Clear();
+	bool Load(const char *szFilename); // read entries from a file, unless it is the one loaded already
+	bool Save(); // write back to the loaded file, if anything changed
+	void CompileFunc(StdCompiler *pComp);
+
+	int32_t Hits, Misses; // functions taken from the cache or generated by the last link
+
+private:
+	std::unordered_map<Key, Variants, KeyHash> Entries;
+	StdCopyStrBuf Filename;
+	int32_t Session; // number of the next save
+	bool Dirty;
+};
+
+#endif
@@ -173,6 +173,11 @@ void C4AulScriptEngine::Link(C4DefList *rDefs)
 		for (C4AulScript *s = Child0; s; s = s->Next)
 			s->ResolveIncludes(rDefs);
 
+		CodeCache.Hits = CodeCache.Misses = 0;
+
+		// lex the scripts once up front, each is parsed again for every script including it
+		Tokenize();
+
 		// parse the scripts to byte code
 		for (C4AulScript *s = Child0; s; s = s->Next)
 			s->Parse();
@@ -196,7 +201,7 @@ void C4AulScriptEngine::Link(C4DefList *rDefs)
 		err.show();
 	}
 
-
+	ClearTokens();
 }
 
 
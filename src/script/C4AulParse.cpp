@@ -17,6 +17,8 @@
 
 #include <C4Include.h>
 #include <utility>
+#include <atomic>
+#include <thread>
 
 #include <C4Aul.h>
 
@@ -115,6 +117,80 @@ enum C4AulTokenType
 	ATT_EOF     // end of file
 };
 
+// a token of a script that was split up before parsing
+struct C4AulToken
+{
+	int32_t Begin; // script offset at which the token was looked for
+	int32_t Start, End; // script offsets of the token and behind it (Start is -1 for ATT_EOF)
+	int32_t Data; // value of ATT_INT and ATT_OPERATOR, index into Strings for ATT_STRING
+	C4AulTokenType Type;
+};
+
+// all tokens of a script, kept while linking. The parser looks them up instead of lexing
+// the script again in each pass and for each script including it.
+class C4AulTokenCache
+{
+public:
+	C4AulTokenCache(const char *Script): Script(Script), Hint(0) { }
+	const char *Script;
+	std::vector<C4AulToken> Tokens;
+	std::vector<std::string> Strings;
+
+	const C4AulToken *Find(int32_t iBegin);
+private:
+	size_t Hint; // index of the token most likely asked for next
+};
+
+const C4AulToken *C4AulTokenCache::Find(int32_t iBegin)
+{
+	if (Hint >= Tokens.size() || Tokens[Hint].Begin != iBegin)
+	{
+		std::vector<C4AulToken>::iterator i = std::lower_bound(Tokens.begin(), Tokens.end(), iBegin,
+		                                      [](const C4AulToken &Token, int32_t iBegin) { return Token.Begin < iBegin; });
+		if (i == Tokens.end() || i->Begin != iBegin) return NULL;
+		Hint = i - Tokens.begin();
+	}
+	return &Tokens[Hint++];
+}
+
+// end of the block opened by the '{' at szPos, found without lexing the script; NULL if not closed
+static const char *FindBlockEnd(const char *szPos)
+{
+	int iDepth = 0;
+	while (*szPos)
+	{
+		char C = *szPos++;
+		if (C == '/' && *szPos == '/')
+		{
+			// // comment
+			while (*szPos && *szPos != 13 && *szPos != 10)
+				++szPos;
+		}
+		else if (C == '/' && *szPos == '*')
+		{
+			// /* comment */
+			for (++szPos; *szPos && (*szPos != '*' || szPos[1] != '/'); ++szPos) { }
+			if (!*szPos) return NULL;
+			szPos += 2;
+		}
+		else if (C == '"')
+		{
+			// string, skipping escaped quotes
+			for (; *szPos != '"'; ++szPos)
+			{
+				if (!*szPos || *szPos == 10 || *szPos == 13) return NULL;
+				if (*szPos == '\\' && (szPos[1] == '"' || szPos[1] == '\\')) ++szPos;
+			}
+			++szPos;
+		}
+		else if (C == '{')
+			++iDepth;
+		else if (C == '}' && !--iDepth)
+			return szPos;
+	}
+	return NULL;
+}
+
 class C4AulParse
 {
 public:
@@ -125,6 +201,7 @@ public:
 			TokenType(ATT_INVALID),
 			Type(Type),
 			ContextToExecIn(NULL),
+			pTokens(NULL), Tokenizing(false), fRecording(false),
 			fJump(false),
 			iStack(0),
 			pLoopStack(NULL)
@@ -135,6 +212,7 @@ public:
 			TokenType(ATT_INVALID),
 			Type(Type),
 			ContextToExecIn(context),
+			pTokens(NULL), Tokenizing(false), fRecording(false),
 			fJump(false),
 			iStack(0),
 			pLoopStack(NULL)
@@ -143,6 +221,7 @@ public:
 	{ while (pLoopStack) PopLoop(); ClearToken(); }
 	void Parse_DirectExec();
 	void Parse_Script(C4ScriptHost *);
+	static void Tokenize(C4ScriptHost *); // split the script into tokens for later Parse_Script calls (thread-safe)
 
 private:
 	C4AulScriptFunc *Fn; C4ScriptHost * Host; C4ScriptHost * pOrgScript;
@@ -155,6 +234,11 @@ private:
 	C4String * cStr; // current string constant
 	enum Type Type; // emitting bytecode?
 	C4AulScriptContext* ContextToExecIn;
+	C4AulTokenCache *pTokens; // tokens of the script being parsed, if any
+	bool Tokenizing; // filling pTokens: do not touch any global state
+	bool fRecording; // noting the lookups of the function body for the code cache
+	C4AulCodeCache::Entry Record; // code cache entry of the function being parsed
+	std::vector<intptr_t> RecordResults; // what each lookup in Record resolved to
 	void Parse_Function();
 	void Parse_Statement();
 	void Parse_Block();
@@ -200,6 +284,14 @@ private:
 	void RemoveLastBCC();
 	C4V_Type GetLastRetType(C4V_Type to); // for warning purposes
 
+	intptr_t Lookup(C4AulCodeCache::LookupKind eKind, const char *szName, C4Value *pConst = NULL); // look up a name for the generated code
+	intptr_t Resolve(C4AulCodeCache::Lookup &rLookup, C4Value *pConst = NULL);
+	int32_t GetFuncSignature(C4AulFunc *pFunc, bool fCall);
+	bool GetCodeCacheKey(const char *pFuncStart, const char **ppBodyEnd, C4AulCodeCache::Key *pKey);
+	bool UseCachedCode(const C4AulCodeCache::Entry &rEntry, const char *pFuncStart);
+	void StoreCode(const C4AulCodeCache::Key &key, const char *pFuncStart, const char *pBodyEnd);
+	int32_t FindRecordedLookup(C4AulCodeCache::LookupKind eKind, C4AulCodeCache::LookupKind eKind2, intptr_t iResult);
+
 	C4AulBCC MakeSetter(bool fLeaveValue = false); // Prepares to generate a setter for the last value that was generated
 
 	int JumpHere(); // Get position for a later jump to next instruction added
@@ -243,6 +335,8 @@ void C4AulScript::Warn(const char *pMsg, ...)
 
 void C4AulParse::Warn(const char *pMsg, ...)
 {
+	// warnings have to be shown in order by the parser itself
+	if (Tokenizing) throw C4AulError();
 	va_list args; va_start(args, pMsg);
 	StdStrBuf Buf;
 	Buf.FormatV(pMsg, args);
@@ -467,6 +561,29 @@ C4AulTokenType C4AulParse::GetNextToken(OperatorPolicy Operator)
 {
 	// clear mem of prev token
 	ClearToken();
+	// take the token from the cache if the script has already been split up
+	if (pTokens && !Tokenizing && Operator == OperatorsPlease)
+		if (const C4AulToken *pToken = pTokens->Find(SPos - pTokens->Script))
+		{
+			if (pToken->Start >= 0) TokenSPos = pTokens->Script + pToken->Start;
+			SPos = pTokens->Script + pToken->End;
+			switch (pToken->Type)
+			{
+			case ATT_IDTF: case ATT_DIR:
+				SCopy(TokenSPos, Idtf, std::min(pToken->End - pToken->Start, C4AUL_MAX_Identifier));
+				break;
+			case ATT_INT: case ATT_OPERATOR:
+				cInt = pToken->Data;
+				break;
+			case ATT_STRING:
+				cStr = Strings.RegString(pTokens->Strings[pToken->Data].data(), pTokens->Strings[pToken->Data].size());
+				cStr->IncRef();
+				break;
+			default:
+				break;
+			}
+			return pToken->Type;
+		}
 	// move to start of token
 	if (!AdvanceSpaces()) return ATT_EOF;
 	// store offset
@@ -598,7 +715,14 @@ C4AulTokenType C4AulParse::GetNextToken(OperatorPolicy Operator)
 				strbuf.push_back(C);
 		}
 		++SPos;
-		cStr = Strings.RegString(StdStrBuf(strbuf.data(),strbuf.size()));
+		if (Tokenizing)
+		{
+			// the string table is registered to on the main thread only
+			cInt = pTokens->Strings.size();
+			pTokens->Strings.push_back(strbuf);
+			return ATT_STRING;
+		}
+		cStr = Strings.RegString(strbuf.data(), strbuf.size());
 		// hold onto string, ClearToken will deref it
 		cStr->IncRef();
 		return ATT_STRING;
@@ -1221,10 +1345,82 @@ void C4AulParse::Parse_DirectExec()
 	AddBCC(AB_EOFN);
 }
 
+void C4AulParse::Tokenize(C4ScriptHost * scripthost)
+{
+	scripthost->ClearTokens();
+	if (!scripthost->Script.getData()) return;
+	C4AulTokenCache *pCache = new C4AulTokenCache(scripthost->Script.getData());
+	C4AulParse state(scripthost, PARSER);
+	state.pTokens = pCache;
+	state.Tokenizing = true;
+	try
+	{
+		C4AulToken Token;
+		do
+		{
+			Token.Begin = state.SPos - pCache->Script;
+			Token.Type = state.GetNextToken();
+			Token.Start = Token.Type != ATT_EOF ? state.TokenSPos - pCache->Script : -1;
+			Token.End = state.SPos - pCache->Script;
+			Token.Data = (Token.Type == ATT_INT || Token.Type == ATT_OPERATOR || Token.Type == ATT_STRING) ? state.cInt : 0;
+			pCache->Tokens.push_back(Token);
+		}
+		while (Token.Type != ATT_EOF);
+	}
+	catch (C4AulError &)
+	{
+		// stop here: the parser lexes the rest itself, and reports the error or warning in order
+	}
+	scripthost->Tokens = pCache;
+}
+
+void C4ScriptHost::ClearTokens()
+{
+	delete Tokens;
+	Tokens = NULL;
+}
+
+void C4AulScriptEngine::Tokenize()
+{
+	std::vector<C4ScriptHost *> Hosts;
+	for (C4AulScript *s = Child0; s; s = s->Next)
+		if (s->GetScriptHost())
+			Hosts.push_back(s->GetScriptHost());
+	// scripts are split up independently, so spread them over all cores
+	const unsigned int MinHostsPerThread = 16;
+	unsigned int iThreadCount = std::min<unsigned int>(std::thread::hardware_concurrency(), Hosts.size() / MinHostsPerThread);
+	if (iThreadCount <= 1)
+	{
+		for (C4ScriptHost *pHost : Hosts)
+			C4AulParse::Tokenize(pHost);
+		return;
+	}
+	std::atomic<size_t> iNextHost(0);
+	auto TokenizeHosts = [&Hosts, &iNextHost]()
+	{
+		for (size_t i = iNextHost++; i < Hosts.size(); i = iNextHost++)
+			C4AulParse::Tokenize(Hosts[i]);
+	};
+	std::vector<std::thread> Threads;
+	for (unsigned int i = 1; i < iThreadCount; ++i)
+		Threads.push_back(std::thread(TokenizeHosts));
+	TokenizeHosts();
+	for (std::thread &Thread : Threads)
+		Thread.join();
+}
+
+void C4AulScriptEngine::ClearTokens()
+{
+	for (C4AulScript *s = Child0; s; s = s->Next)
+		if (s->GetScriptHost())
+			s->GetScriptHost()->ClearTokens();
+}
+
 void C4AulParse::Parse_Script(C4ScriptHost * scripthost)
 {
 	pOrgScript = scripthost;
 	SPos = pOrgScript->Script.getData();
+	pTokens = (scripthost->Tokens && scripthost->Tokens->Script == SPos) ? scripthost->Tokens : NULL;
 	const char * SPos0 = SPos;
 	bool all_ok = true;
 	bool found_code = false;
@@ -1315,6 +1511,7 @@ void C4AulParse::Parse_Script(C4ScriptHost * scripthost)
 	}
 	catch (C4AulError &err)
 	{
+		fRecording = false;
 		// damn! something went wrong, print it out
 		// but only one error per function
 		if (all_ok)
@@ -1341,8 +1538,224 @@ void C4AulParse::Parse_Script(C4ScriptHost * scripthost)
 	}
 }
 
+intptr_t C4AulParse::Lookup(C4AulCodeCache::LookupKind eKind, const char *szName, C4Value *pConst)
+{
+	C4AulCodeCache::Lookup L;
+	L.Kind = eKind;
+	L.Name.Ref(szName);
+	intptr_t iResult = Resolve(L, pConst);
+	if (fRecording)
+	{
+		Record.Lookups.push_back(L);
+		RecordResults.push_back(iResult);
+	}
+	return iResult;
+}
+
+intptr_t C4AulParse::Resolve(C4AulCodeCache::Lookup &L, C4Value *pConst)
+{
+	const char *szName = L.Name.getData();
+	C4AulFunc *pFunc = NULL;
+	switch (L.Kind)
+	{
+	case C4AulCodeCache::LK_Local:
+		return L.Result = Host && Host->LocalNamed.GetItemNr(szName) != -1;
+	case C4AulCodeCache::LK_GlobalVar:
+	{
+		int32_t iIndex = Engine->GlobalNamedNames.GetItemNr(szName);
+		L.Result = iIndex != -1;
+		return iIndex;
+	}
+	case C4AulCodeCache::LK_Const:
+	{
+		C4Value val;
+		if (!Engine->GetGlobalConstant(szName, &val)) return 0;
+		if (pConst) *pConst = val;
+		L.Result = val.GetType() + 1;
+		switch (val.GetType())
+		{
+		case C4V_Int: L.Value = val._getInt(); return 1;
+		case C4V_Bool: L.Value = val._getBool(); return 1;
+		case C4V_String: L.Text.Copy(val._getStr()->GetData()); return 1;
+		case C4V_PropList: L.Value = !!val._getPropList()->GetDef(); return (intptr_t) val._getPropList();
+		case C4V_Array: return (intptr_t) val._getArray();
+		case C4V_Function: return (intptr_t) val._getFunction();
+		default: return 1;
+		}
+	}
+	case C4AulCodeCache::LK_Func:
+		pFunc = Fn->Owner->GetPropList()->GetFunc(szName);
+		break;
+	case C4AulCodeCache::LK_Inherited:
+		pFunc = Fn->OwnerOverloaded;
+		break;
+	case C4AulCodeCache::LK_Call:
+	{
+		C4String *pName = ::Strings.FindString(szName);
+		if (pName) pFunc = Engine->GetFirstFunc(pName);
+		break;
+	}
+	}
+	if (pFunc)
+	{
+		L.Result = pFunc->GetParCount() + 1;
+		L.Value = GetFuncSignature(pFunc, L.Kind == C4AulCodeCache::LK_Call);
+	}
+	return (intptr_t) pFunc;
+}
+
+int32_t C4AulParse::GetFuncSignature(C4AulFunc *pFunc, bool fCall)
+{
+	// the types the parser checks the parameters and the return value against
+	C4V_Type ParTypes[C4AUL_MAX_Par];
+	std::copy(pFunc->GetParType(), pFunc->GetParType() + C4AUL_MAX_Par, ParTypes);
+	uint32_t dwRetTypes = 0;
+	for (C4AulFunc *pFunc2 = pFunc; pFunc2; pFunc2 = Engine->GetNextSNFunc(pFunc2))
+	{
+		for (int i = 0; i < C4AUL_MAX_Par; ++i)
+			if (pFunc2->GetParType()[i] != ParTypes[i]) ParTypes[i] = C4V_Any;
+		dwRetTypes |= 1 << pFunc2->GetRetType();
+	}
+	uint32_t dwSignature = fCall ? dwRetTypes : uint32_t(pFunc->GetRetType());
+	dwSignature = dwSignature * 2 + pFunc->GetPublic();
+	for (int i = 0; i < C4AUL_MAX_Par; ++i)
+		dwSignature = dwSignature * 31 + ParTypes[i];
+	return dwSignature;
+}
+
+bool C4AulParse::GetCodeCacheKey(const char *pFuncStart, const char **ppBodyEnd, C4AulCodeCache::Key *pKey)
+{
+	// switched off, or the debugger and extra warnings change the generated code or need the parser to run
+	if (!Config.Developer.ScriptCache || C4AulDebug::GetDebugger() || Config.Developer.ExtraWarnings) return false;
+	if (TokenType != ATT_BLOPEN) return false;
+	*ppBodyEnd = FindBlockEnd(TokenSPos);
+	if (!*ppBodyEnd) return false;
+	*pKey = C4AulCodeCache::GetKey(pFuncStart, *ppBodyEnd - pFuncStart);
+	return true;
+}
+
+bool C4AulParse::UseCachedCode(const C4AulCodeCache::Entry &rEntry, const char *pFuncStart)
+{
+	if (rEntry.ParCount != Fn->GetParCount() || rEntry.VarCount != Fn->VarNamed.iSize) return false;
+	// every name has to resolve as it did when the code was generated
+	std::vector<intptr_t> Results(rEntry.Lookups.size());
+	for (size_t i = 0; i < rEntry.Lookups.size(); ++i)
+	{
+		C4AulCodeCache::Lookup L;
+		L.Kind = rEntry.Lookups[i].Kind;
+		L.Name.Ref(rEntry.Lookups[i].Name);
+		Results[i] = Resolve(L);
+		if (!(L == rEntry.Lookups[i])) return false;
+	}
+	// check the code before adding any of it
+	int32_t iSize = rEntry.Code.size();
+	if (!iSize || rEntry.Code.back().Type != AB_EOFN) return false;
+	for (int32_t i = 0; i < iSize; ++i)
+	{
+		const C4AulCodeCache::Chunk &c = rEntry.Code[i];
+		if (c.Type < 0 || c.Type > AB_EOFN || c.Pos < 0 || c.Pos > rEntry.Length) return false;
+		switch (c.Type)
+		{
+		case AB_STRING: case AB_CALL: case AB_CALLFS: case AB_LOCALN: case AB_LOCALN_SET: case AB_PROP: case AB_PROP_SET:
+			if (c.Par < 0 || c.Par >= int32_t(rEntry.Strings.size())) return false;
+			break;
+		case AB_FUNC: case AB_GLOBALN: case AB_GLOBALN_SET: case AB_CPROPLIST: case AB_CARRAY: case AB_CFUNCTION:
+			if (c.Par < 0 || c.Par >= int32_t(Results.size()) || !rEntry.Lookups[c.Par].Result) return false;
+			break;
+		case AB_PARN_CONTEXT: case AB_VARN_CONTEXT: case AB_ERR: case AB_DEBUG:
+			return false;
+		default:
+			if (IsJump(C4AulBCCType(c.Type)) && (i + c.Par < 0 || i + c.Par >= iSize)) return false;
+			break;
+		}
+	}
+	for (const C4AulCodeCache::Chunk &c : rEntry.Code)
+	{
+		intptr_t X;
+		switch (c.Type)
+		{
+		case AB_STRING: case AB_CALL: case AB_CALLFS: case AB_LOCALN: case AB_LOCALN_SET: case AB_PROP: case AB_PROP_SET:
+			X = (intptr_t) ::Strings.RegString(rEntry.Strings[c.Par]);
+			break;
+		case AB_FUNC: case AB_GLOBALN: case AB_GLOBALN_SET: case AB_CPROPLIST: case AB_CARRAY: case AB_CFUNCTION:
+			X = Results[c.Par];
+			break;
+		default:
+			X = c.Par;
+			break;
+		}
+		Fn->AddBCC(C4AulBCCType(c.Type), X, pFuncStart + c.Pos);
+		// setters hold a reference of their own, see MakeSetter
+		if (c.Type == AB_LOCALN_SET || c.Type == AB_PROP_SET)
+			Fn->GetLastCode()->Par.s->IncRef();
+	}
+	return true;
+}
+
+int32_t C4AulParse::FindRecordedLookup(C4AulCodeCache::LookupKind eKind, C4AulCodeCache::LookupKind eKind2, intptr_t iResult)
+{
+	int32_t iFound = -1;
+	for (size_t i = 0; i < Record.Lookups.size(); ++i)
+	{
+		const C4AulCodeCache::Lookup &L = Record.Lookups[i];
+		if ((L.Kind != eKind && L.Kind != eKind2) || RecordResults[i] != iResult) continue;
+		if (iFound < 0)
+			iFound = i;
+		// the same thing under different names: no telling which one the code refers to
+		else if (L.Kind != Record.Lookups[iFound].Kind || L.Name != Record.Lookups[iFound].Name)
+			return -1;
+	}
+	return iFound;
+}
+
+void C4AulParse::StoreCode(const C4AulCodeCache::Key &key, const char *pFuncStart, const char *pBodyEnd)
+{
+	C4AulCodeCache::Entry &E = Record;
+	if (E.ParCount != Fn->GetParCount()) return;
+	E.Length = pBodyEnd - pFuncStart;
+	E.VarCount = Fn->VarNamed.iSize;
+	for (size_t i = 0; i < Fn->Code.size(); ++i)
+	{
+		const C4AulBCC &bcc = Fn->Code[i];
+		C4AulCodeCache::Chunk c;
+		c.Type = bcc.bccType;
+		c.Pos = Fn->PosForCode[i] - pFuncStart;
+		if (c.Pos < 0 || c.Pos > E.Length) return;
+		switch (bcc.bccType)
+		{
+		case AB_STRING: case AB_CALL: case AB_CALLFS: case AB_LOCALN: case AB_LOCALN_SET: case AB_PROP: case AB_PROP_SET:
+			// the cache file cannot hold strings with embedded zeros
+			if (SLen(bcc.Par.s->GetCStr()) != bcc.Par.s->GetData().getLength()) return;
+			c.Par = E.Strings.size();
+			E.Strings.push_back(StdCopyStrBuf(bcc.Par.s->GetData()));
+			break;
+		case AB_FUNC:
+			c.Par = FindRecordedLookup(C4AulCodeCache::LK_Func, C4AulCodeCache::LK_Inherited, (intptr_t) bcc.Par.f);
+			if (c.Par < 0) return;
+			break;
+		case AB_GLOBALN: case AB_GLOBALN_SET:
+			c.Par = FindRecordedLookup(C4AulCodeCache::LK_GlobalVar, C4AulCodeCache::LK_GlobalVar, bcc.Par.i);
+			if (c.Par < 0) return;
+			break;
+		case AB_CPROPLIST: case AB_CARRAY: case AB_CFUNCTION:
+			c.Par = FindRecordedLookup(C4AulCodeCache::LK_Const, C4AulCodeCache::LK_Const, bcc.Par.X);
+			if (c.Par < 0) return;
+			break;
+		case AB_PARN_CONTEXT: case AB_VARN_CONTEXT: case AB_ERR: case AB_DEBUG:
+			return;
+		default:
+			c.Par = bcc.Par.i;
+			break;
+		}
+		E.Code.push_back(c);
+	}
+	Engine->CodeCache.Store(key, E);
+}
+
 void C4AulParse::Parse_Function()
 {
+	const char *pFuncStart = TokenSPos;
+	fRecording = false;
 	bool is_global = SEqual(Idtf, C4AUL_Global);
 	// skip access modifier
 	if (SEqual(Idtf, C4AUL_Private) ||
@@ -1469,6 +1882,31 @@ void C4AulParse::Parse_Function()
 		cpar++;
 	}
 	Match(ATT_BCLOSE);
+	// reuse the code generated for the same text earlier if all names still mean the same
+	C4AulCodeCache::Key CacheKey;
+	const char *pBodyEnd = NULL;
+	if (Type == PARSER && GetCodeCacheKey(pFuncStart, &pBodyEnd, &CacheKey))
+	{
+		const std::vector<C4AulCodeCache::Entry> *pEntries = Engine->CodeCache.Find(CacheKey);
+		bool fHit = false;
+		if (pEntries)
+			for (const C4AulCodeCache::Entry &rEntry : *pEntries)
+				if ((fHit = UseCachedCode(rEntry, pFuncStart)))
+					break;
+		Engine->CodeCache.CountHit(fHit);
+		if (fHit)
+		{
+			Fn = 0;
+			SPos = pBodyEnd;
+			Shift();
+			return;
+		}
+		fRecording = true;
+		Record = C4AulCodeCache::Entry();
+		Record.ParCount = Fn->GetParCount();
+		RecordResults.clear();
+	}
+	int iWarnCnt = ::ScriptEngine.warnCnt;
 	Match(ATT_BLOPEN);
 	// Push variables
 	if (Fn->VarNamed.iSize)
@@ -1489,6 +1927,10 @@ void C4AulParse::Parse_Function()
 	}
 	// add separator
 	AddBCC(AB_EOFN);
+	// code that caused warnings is generated again to show them again
+	if (fRecording && ::ScriptEngine.warnCnt == iWarnCnt && SPos == pBodyEnd)
+		StoreCode(CacheKey, pFuncStart, pBodyEnd);
+	fRecording = false;
 
 	// dump bytecode
 	if (DEBUG_BYTECODE_DUMP && Type == PARSER)
@@ -2223,7 +2665,7 @@ void C4AulParse::Parse_Expression(int iParentPrio)
 			Shift();
 		}
 		// check for variable (local)
-		else if (Host && Host->LocalNamed.GetItemNr(Idtf) != -1)
+		else if (Host && Lookup(C4AulCodeCache::LK_Local, Idtf))
 		{
 			// global func?
 			if (Fn->Owner == &::ScriptEngine)
@@ -2296,7 +2738,7 @@ void C4AulParse::Parse_Expression(int iParentPrio)
 		{
 			Shift();
 			// get function
-			if (Fn->OwnerOverloaded)
+			if (Lookup(C4AulCodeCache::LK_Inherited, ""))
 			{
 				// add direct call to byte code
 				Parse_Params(Fn->OwnerOverloaded->GetParCount(), NULL, Fn->OwnerOverloaded);
@@ -2323,7 +2765,7 @@ void C4AulParse::Parse_Expression(int iParentPrio)
 			if (TokenType == ATT_BOPEN)
 				Parse_Params(10, NULL);
 		}
-		else if ((FoundFn = Fn->Owner->GetPropList()->GetFunc(Idtf)))
+		else if ((FoundFn = (C4AulFunc *) Lookup(C4AulCodeCache::LK_Func, Idtf)))
 		{
 			assert(Host == Fn->Owner || Fn->Owner == Engine || (Host && !Host->GetPropList()));
 			if (Config.Developer.ExtraWarnings && !FoundFn->GetPublic())
@@ -2336,13 +2778,13 @@ void C4AulParse::Parse_Expression(int iParentPrio)
 		// check for global variables (static) or constants (static const)
 		// the global namespace has the lowest priority so that local
 		// functions and variables can overload it
-		else if ((ndx = Engine->GlobalNamedNames.GetItemNr(Idtf)) != -1)
+		else if ((ndx = Lookup(C4AulCodeCache::LK_GlobalVar, Idtf)) != -1)
 		{
 			// insert variable by id
 			AddBCC(AB_GLOBALN, ndx);
 			Shift();
 		}
-		else if (Engine->GetGlobalConstant(Idtf, &val))
+		else if (Lookup(C4AulCodeCache::LK_Const, Idtf, &val))
 		{
 			// store as direct constant
 			switch (val.GetType())
@@ -2596,7 +3038,7 @@ void C4AulParse::Parse_Expression2(int iParentPrio)
 			if (Type == PARSER)
 			{
 				pName = ::Strings.RegString(Idtf);
-				pFunc = Engine->GetFirstFunc(pName);
+				pFunc = (C4AulFunc *) Lookup(C4AulCodeCache::LK_Call, Idtf);
 			}
 			Shift();
 			Parse_Params(C4AUL_MAX_Par, pName ? pName->GetCStr() : Idtf, pFunc);
@@ -2640,6 +3082,8 @@ void C4AulParse::Parse_Var()
 
 void C4AulParse::Parse_Local()
 {
+	// changes the script, so code of the function cannot be reused
+	fRecording = false;
 	Shift();
 	while (1)
 	{
@@ -2673,6 +3117,8 @@ void C4AulParse::Parse_Local()
 
 void C4AulParse::Parse_Static()
 {
+	// changes the engine, so code of the function cannot be reused
+	fRecording = false;
 	Shift();
 	// constant?
 	if (TokenType == ATT_IDTF && SEqual(Idtf, C4AUL_Const))
@@ -2880,7 +3326,7 @@ bool C4AulScript::Parse()
 	return true;
 }
 
-void C4ScriptHost::CopyPropList(C4Set<C4Property> & from, C4PropListStatic * to)
+void C4ScriptHost::CopyPropList(C4PropListProperties & from, C4PropListStatic * to)
 {
 	// append all funcs and local variable initializations
 	const C4Property * prop = from.First();
@@ -312,9 +312,9 @@ bool C4PropList::operator==(const C4PropList &b) const
 	const C4Property * p = Properties.First();
 	while (p)
 	{
-		const C4Property & bp = b.Properties.Get(p->Key);
+		const C4Property * bp = b.Properties.Find(p->Key);
 		if (!bp) return false;
-		if (p->Value != bp.Value) return false;
+		if (p->Value != bp->Value) return false;
 		p = Properties.Next(p);
 	}
 	return true;
@@ -345,9 +345,9 @@ void C4PropList::CompileFunc(StdCompiler *pComp, C4ValueNumbers * numbers)
 	pComp->Value(mkParAdapt(Properties, numbers));
 	if (oldFormat)
 	{
-		if (Properties.Has(&::Strings.P[P_Prototype]))
+		if (const C4Property * p = Properties.Find(&::Strings.P[P_Prototype]))
 		{
-			prototype = Properties.Get(&::Strings.P[P_Prototype]).Value;
+			prototype = p->Value;
 			Properties.Remove(&::Strings.P[P_Prototype]);
 		}
 	}
@@ -371,8 +371,293 @@ void CompileNewFunc(C4PropList *&pStruct, StdCompiler *pComp, C4ValueNumbers * c
 	pStruct = temp.release();
 }
 
-template<typename T>
-void C4Set<T>::CompileFunc(StdCompiler *pComp, C4ValueNumbers * numbers)
+template<> template<>
+unsigned int C4Set<C4Property>::Hash<C4String *>(C4String * const & e)
+{
+	assert(e);
+	unsigned int hash = 4, tmp;
+	hash += ((uintptr_t)e) >> 16;
+	tmp   = ((((uintptr_t)e) & 0xffff) << 11) ^ hash;
+	hash  = (hash << 16) ^ tmp;
+	hash += hash >> 11;
+	hash ^= hash << 3;
+	hash += hash >> 5;
+	hash ^= hash << 4;
+	hash += hash >> 17;
+	hash ^= hash << 25;
+	hash += hash >> 6;
+	return hash;
+}
+
+template<> template<>
+bool C4Set<C4Property>::Equals<C4String *>(C4Property const & a, C4String * const & b)
+{
+	return a.Key == b;
+}
+
+template<> template<>
+unsigned int C4Set<C4Property>::Hash<C4Property>(C4Property const & p)
+{
+	return C4Set<C4Property>::Hash(p.Key);
+}
+
+template<> template<>
+unsigned int C4Set<C4PropListKeyPos>::Hash<C4String *>(C4String * const & e)
+{
+	return C4Set<C4Property>::Hash(e);
+}
+
+template<> template<>
+unsigned int C4Set<C4PropListKeyPos>::Hash<C4PropListKeyPos>(C4PropListKeyPos const & e)
+{
+	return C4Set<C4Property>::Hash(e.Key);
+}
+
+template<> template<>
+bool C4Set<C4PropListKeyPos>::Equals<C4String *>(C4PropListKeyPos const & a, C4String * const & b)
+{
+	return a.Key == b;
+}
+
+template<> template<>
+unsigned int C4Set<C4PropListShape *>::Hash<C4String *>(C4String * const & e)
+{
+	return C4Set<C4Property>::Hash(e);
+}
+
+template<> template<>
+unsigned int C4Set<C4PropListShape *>::Hash<C4PropListShape *>(C4PropListShape * const & e)
+{
+	return C4Set<C4Property>::Hash(e->GetLastKey());
+}
+
+template<> template<>
+bool C4Set<C4PropListShape *>::Equals<C4String *>(C4PropListShape * const & a, C4String * const & b)
+{
+	return a->GetLastKey() == b;
+}
+
+C4PropListShape::KeyList::~KeyList()
+{
+	for (C4String *k : Keys) k->DecRef();
+	delete Index;
+}
+
+void C4PropListShape::KeyList::Add(C4String * k)
+{
+	k->IncRef();
+	Keys.push_back(k);
+	// a linear search is faster for few keys
+	if (Index)
+		Index->Add(C4PropListKeyPos(k, Keys.size() - 1));
+	else if (Keys.size() > 8)
+	{
+		Index = new C4Set<C4PropListKeyPos>;
+		for (size_t i = 0; i < Keys.size(); ++i)
+			Index->Add(C4PropListKeyPos(Keys[i], i));
+	}
+}
+
+void C4PropListShape::KeyList::RemoveLast()
+{
+	if (Index) Index->Remove(Keys.back());
+	Keys.back()->DecRef();
+	Keys.pop_back();
+}
+
+C4PropListShape *C4PropListShape::GetEmpty()
+{
+	// never freed, so that proplists can be destroyed in any order at shutdown
+	static C4PropListShape *Empty = new C4PropListShape();
+	return Empty;
+}
+
+C4PropListShape::C4PropListShape(C4PropListShape * Parent, C4String * k):
+		RefCnt(1), Parent(Parent), Keys(Parent->Keys), Size(Parent->Size + 1), Transitions(NULL)
+{
+	Parent->IncRef();
+	if (Keys && Keys->Keys.size() == Parent->Size)
+	{
+		// the parent's keys end where ours continue
+		Keys->IncRef();
+	}
+	else
+	{
+		// another shape branched off here first
+		Keys = new KeyList;
+		for (size_t i = 0; i < Parent->Size; ++i)
+			Keys->Add(Parent->Keys->Keys[i]);
+	}
+	Keys->Add(k);
+	if (!Parent->Transitions) Parent->Transitions = new C4Set<C4PropListShape *>;
+	Parent->Transitions->Add(this);
+}
+
+C4PropListShape::~C4PropListShape()
+{
+	delete Transitions;
+	if (!Parent) return;
+	Parent->Transitions->Remove(GetLastKey());
+	// the key is not needed by any other shape if it is the last one of the list
+	if (Keys->Keys.size() == Size)
+		Keys->RemoveLast();
+	Keys->DecRef();
+	Parent->DecRef();
+}
+
+int32_t C4PropListShape::Find(C4String * k) const
+{
+	if (!Keys) return -1;
+	if (Keys->Index)
+	{
+		const C4PropListKeyPos &p = Keys->Index->Get(k);
+		return p && size_t(p.Pos) < Size ? p.Pos : -1;
+	}
+	for (size_t i = 0; i < Size; ++i)
+		if (Keys->Keys[i] == k) return i;
+	return -1;
+}
+
+C4PropListShape *C4PropListShape::WithKey(C4String * k)
+{
+	if (Transitions)
+		if (C4PropListShape *s = Transitions->Get(k))
+		{
+			s->IncRef();
+			return s;
+		}
+	return new C4PropListShape(this, k);
+}
+
+C4PropListProperties::C4PropListProperties():
+		Shape(C4PropListShape::GetEmpty()), Dictionary(NULL)
+{
+	Shape->IncRef();
+}
+
+C4PropListProperties::C4PropListProperties(const C4PropListProperties &other):
+		Shape(C4PropListShape::GetEmpty()), Dictionary(NULL)
+{
+	Shape->IncRef();
+	*this = other;
+}
+
+C4PropListProperties &C4PropListProperties::operator = (const C4PropListProperties &other)
+{
+	if (this == &other) return *this;
+	Clear();
+	if (other.Shape)
+	{
+		// the values are stored in the same order, so the shape can be shared
+		other.Shape->IncRef();
+		Shape->DecRef();
+		Shape = other.Shape;
+		Slots = other.Slots;
+	}
+	else
+	{
+		Shape->DecRef();
+		Shape = NULL;
+		Dictionary = new C4Set<C4Property>(*other.Dictionary);
+	}
+	return *this;
+}
+
+C4PropListProperties::~C4PropListProperties()
+{
+	Clear();
+	Shape->DecRef();
+}
+
+const C4Property *C4PropListProperties::First() const
+{
+	if (!Shape) return Dictionary->First();
+	return Slots.empty() ? NULL : &Slots[0];
+}
+
+const C4Property *C4PropListProperties::Next(const C4Property *p) const
+{
+	if (!Shape) return Dictionary->Next(p);
+	return ++p != &Slots[0] + Slots.size() ? p : NULL;
+}
+
+C4Property *C4PropListProperties::Find(C4String * k)
+{
+	if (!Shape)
+	{
+		C4Property &p = Dictionary->Get(k);
+		return p ? &p : NULL;
+	}
+	int32_t i = Shape->Find(k);
+	return i >= 0 ? &Slots[i] : NULL;
+}
+
+void C4PropListProperties::Add(C4Property && p)
+{
+	assert(!Has(p.Key));
+	if (Shape && Slots.size() >= C4PropListShape::MaxKeys)
+		MakeDictionary();
+	if (!Shape)
+	{
+		Dictionary->Add(std::move(p));
+		return;
+	}
+	C4PropListShape *NewShape = Shape->WithKey(p.Key);
+	Shape->DecRef();
+	Shape = NewShape;
+	Slots.push_back(std::move(p));
+}
+
+void C4PropListProperties::Remove(C4String * k)
+{
+	if (!Shape)
+	{
+		if (Dictionary->Has(k)) Dictionary->Remove(k);
+		return;
+	}
+	if (Shape->Find(k) < 0) return;
+	// rebuilding the shape would leave shapes for every order of removals behind
+	MakeDictionary();
+	Dictionary->Remove(k);
+}
+
+void C4PropListProperties::Clear()
+{
+	Slots.clear();
+	delete Dictionary;
+	Dictionary = NULL;
+	if (Shape) Shape->DecRef();
+	Shape = C4PropListShape::GetEmpty();
+	Shape->IncRef();
+}
+
+void C4PropListProperties::Swap(C4PropListProperties * other)
+{
+	std::swap(Shape, other->Shape);
+	std::swap(Dictionary, other->Dictionary);
+	Slots.swap(other->Slots);
+}
+
+void C4PropListProperties::MakeDictionary()
+{
+	assert(Shape);
+	Dictionary = new C4Set<C4Property>;
+	for (C4Property &p : Slots)
+		Dictionary->Add(std::move(p));
+	std::vector<C4Property>().swap(Slots);
+	Shape->DecRef();
+	Shape = NULL;
+}
+
+std::list<const C4Property *> C4PropListProperties::GetSortedListOfElementPointers() const
+{
+	std::list<const C4Property *> result;
+	for (const C4Property *p = First(); p; p = Next(p)) result.push_back(p);
+	result.sort([](const C4Property *p1, const C4Property *p2) { return *p1 < *p2; });
+	return result;
+}
+
+void C4PropListProperties::CompileFunc(StdCompiler *pComp, C4ValueNumbers * numbers)
 {
 	bool fNaming = pComp->hasNaming();
 	if (pComp->isCompiler())
@@ -391,11 +676,13 @@ void C4Set<T>::CompileFunc(StdCompiler *pComp, C4ValueNumbers * numbers)
 			// Read entries
 			try
 			{
-				T e;
-				// This could use the same technique StdArrayAdapt uses
-				// instead of hardcoding mkParAdapt here
+				C4Property e;
 				pComp->Value(mkParAdapt(e, numbers));
-				Add(e);
+				// later entries with the same key win, as with a plain hash set
+				if (C4Property *p = Find(e.Key))
+					*p = std::move(e);
+				else
+					Add(std::move(e));
 			}
 			catch (StdCompiler::NotFoundException *pEx)
 			{
@@ -415,10 +702,10 @@ void C4Set<T>::CompileFunc(StdCompiler *pComp, C4ValueNumbers * numbers)
 			pComp->Value(iSize);
 		}
 		// Write all entries
-		const T * p = First();
+		const C4Property * p = First();
 		while (p)
 		{
-			pComp->Value(mkParAdapt(*const_cast<T *>(p), numbers));
+			pComp->Value(mkParAdapt(*const_cast<C4Property *>(p), numbers));
 			p = Next(p);
 			if (p) pComp->Separator(StdCompiler::SEP_SEP);
 		}
@@ -521,41 +808,11 @@ C4Effect * C4PropList::GetEffect()
 }
 
 
-template<> template<>
-unsigned int C4Set<C4Property>::Hash<C4String *>(C4String * const & e)
-{
-	assert(e);
-	unsigned int hash = 4, tmp;
-	hash += ((uintptr_t)e) >> 16;
-	tmp   = ((((uintptr_t)e) & 0xffff) << 11) ^ hash;
-	hash  = (hash << 16) ^ tmp;
-	hash += hash >> 11;
-	hash ^= hash << 3;
-	hash += hash >> 5;
-	hash ^= hash << 4;
-	hash += hash >> 17;
-	hash ^= hash << 25;
-	hash += hash >> 6;
-	return hash;
-}
-
-template<> template<>
-bool C4Set<C4Property>::Equals<C4String *>(C4Property const & a, C4String * const & b)
-{
-	return a.Key == b;
-}
-
-template<> template<>
-unsigned int C4Set<C4Property>::Hash<C4Property>(C4Property const & p)
-{
-	return C4Set<C4Property>::Hash(p.Key);
-}
-
 bool C4PropList::GetPropertyByS(C4String * k, C4Value *pResult) const
 {
-	if (Properties.Has(k))
+	if (const C4Property * p = Properties.Find(k))
 	{
-		*pResult = Properties.Get(k).Value;
+		*pResult = p->Value;
 		return true;
 	}
 	else if (k == &Strings.P[P_Prototype])
@@ -572,9 +829,9 @@ bool C4PropList::GetPropertyByS(C4String * k, C4Value *pResult) const
 C4String * C4PropList::GetPropertyStr(C4PropertyName n) const
 {
 	C4String * k = &Strings.P[n];
-	if (Properties.Has(k))
+	if (const C4Property * p = Properties.Find(k))
 	{
-		return Properties.Get(k).Value.getStr();
+		return p->Value.getStr();
 	}
 	if (GetPrototype())
 	{
@@ -586,9 +843,9 @@ C4String * C4PropList::GetPropertyStr(C4PropertyName n) const
 C4ValueArray * C4PropList::GetPropertyArray(C4PropertyName n) const
 {
 	C4String * k = &Strings.P[n];
-	if (Properties.Has(k))
+	if (const C4Property * p = Properties.Find(k))
 	{
-		return Properties.Get(k).Value.getArray();
+		return p->Value.getArray();
 	}
 	if (GetPrototype())
 	{
@@ -600,9 +857,9 @@ C4ValueArray * C4PropList::GetPropertyArray(C4PropertyName n) const
 C4AulFunc * C4PropList::GetFunc(C4String * k) const
 {
 	assert(k);
-	if (Properties.Has(k))
+	if (const C4Property * p = Properties.Find(k))
 	{
-		return Properties.Get(k).Value.getFunction();
+		return p->Value.getFunction();
 	}
 	if (GetPrototype())
 	{
@@ -642,9 +899,9 @@ C4Value C4PropList::Call(const char * s, C4AulParSet *Pars, bool fPassErrors)
 C4PropertyName C4PropList::GetPropertyP(C4PropertyName n) const
 {
 	C4String * k = &Strings.P[n];
-	if (Properties.Has(k))
+	if (const C4Property * p = Properties.Find(k))
 	{
-		C4String * v = Properties.Get(k).Value.getStr();
+		C4String * v = p->Value.getStr();
 		if (v >= &Strings.P[0] && v < &Strings.P[P_LAST])
 			return C4PropertyName(v - &Strings.P[0]);
 		return P_LAST;
@@ -659,9 +916,9 @@ C4PropertyName C4PropList::GetPropertyP(C4PropertyName n) const
 int32_t C4PropList::GetPropertyInt(C4PropertyName n, int32_t default_val) const
 {
 	C4String * k = &Strings.P[n];
-	if (Properties.Has(k))
+	if (const C4Property * p = Properties.Find(k))
 	{
-		return Properties.Get(k).Value.getInt();
+		return p->Value.getInt();
 	}
 	if (GetPrototype())
 	{
@@ -673,9 +930,9 @@ int32_t C4PropList::GetPropertyInt(C4PropertyName n, int32_t default_val) const
 C4PropList *C4PropList::GetPropertyPropList(C4PropertyName n) const
 {
 	C4String * k = &Strings.P[n];
-	if (Properties.Has(k))
+	if (const C4Property * p = Properties.Find(k))
 	{
-		return Properties.Get(k).Value.getPropList();
+		return p->Value.getPropList();
 	}
 	if (GetPrototype())
 	{
@@ -712,7 +969,12 @@ C4ValueArray * C4PropList::GetProperties() const
 
 C4String * C4PropList::EnumerateOwnFuncs(C4String * prev) const
 {
-	const C4Property * p = prev ? Properties.Next(&Properties.Get(prev)) : Properties.First();
+	const C4Property * p = Properties.First();
+	if (prev)
+	{
+		p = Properties.Find(prev);
+		if (p) p = Properties.Next(p);
+	}
 	while (p)
 	{
 		if (p->Value.getFunction())
@@ -733,9 +995,9 @@ void C4PropList::SetPropertyByS(C4String * k, const C4Value & to)
 				throw C4AulExecError("Trying to create cyclic prototype structure");
 		prototype.SetPropList(newpt);
 	}
-	else if (Properties.Has(k))
+	else if (C4Property * p = Properties.Find(k))
 	{
-		Properties.Get(k).Value = to;
+		p->Value = to;
 	}
 	else
 	{
@@ -16,6 +16,7 @@
 /* Property lists */
 
 #include <memory>
+#include <vector>
 
 #include "C4Value.h"
 #include "C4StringTable.h"
@@ -61,6 +62,92 @@ public:
 	bool operator < (const C4Property &cmp) const { return strcmp(GetSafeKey(), cmp.GetSafeKey())<0; }
 	const char *GetSafeKey() const { if (Key && Key->GetCStr()) return Key->GetCStr(); return ""; } // get key as C string; return "" if undefined. never return NULL
 };
+
+// position of a key in the key list of a shape
+struct C4PropListKeyPos
+{
+	C4PropListKeyPos(): Key(0), Pos(0) {}
+	C4PropListKeyPos(C4String *Key, int32_t Pos): Key(Key), Pos(Pos) {}
+	C4String * Key;
+	int32_t Pos;
+	operator const void * () const { return Key; }
+	C4PropListKeyPos & operator = (void * p) { assert(!p); Key = 0; Pos = 0; return *this; }
+};
+
+// The keys of a proplist in the order they were added. Proplists which got the same keys in the
+// same order share a shape, so each of them only has to store the property values.
+class C4PropListShape
+{
+public:
+	// proplists with more keys get a hash table of their own instead
+	static const size_t MaxKeys = 64;
+	static C4PropListShape *GetEmpty();
+
+	size_t GetSize() const { return Size; }
+	C4String *GetLastKey() const { return Keys->Keys[Size - 1]; }
+	int32_t Find(C4String * k) const; // index of k, or -1
+	C4PropListShape *WithKey(C4String * k); // shape with k appended. The caller gets a reference to it.
+
+	void IncRef() { ++RefCnt; }
+	void DecRef() { if (!--RefCnt) delete this; }
+
+private:
+	// Keys of a chain of shapes. A shape appends its key to the list of its parent unless another
+	// shape did so already, so a list is only copied where shapes branch off.
+	struct KeyList
+	{
+		int RefCnt;
+		std::vector<C4String *> Keys; // referenced
+		C4Set<C4PropListKeyPos> *Index; // for lists with many keys
+		KeyList(): RefCnt(1), Index(NULL) { }
+		~KeyList();
+		void Add(C4String * k);
+		void RemoveLast();
+		void IncRef() { ++RefCnt; }
+		void DecRef() { if (!--RefCnt) delete this; }
+	};
+
+	C4PropListShape(): RefCnt(1), Parent(NULL), Keys(NULL), Size(0), Transitions(NULL) { }
+	C4PropListShape(C4PropListShape * Parent, C4String * k);
+	~C4PropListShape();
+
+	int RefCnt;
+	C4PropListShape *Parent; // shape without the last key
+	KeyList *Keys; // the first Size keys are those of this shape; NULL for the empty shape
+	size_t Size;
+	C4Set<C4PropListShape *> *Transitions; // shapes with one more key, by that key; not referenced
+};
+
+// The properties of a single proplist: values in the order of a shared shape,
+// or a hash table if the proplist has too many keys or had keys removed
+class C4PropListProperties
+{
+public:
+	C4PropListProperties();
+	~C4PropListProperties();
+	C4PropListProperties(const C4PropListProperties &other);
+	C4PropListProperties &operator = (const C4PropListProperties &other);
+
+	unsigned int GetSize() const { return Shape ? Slots.size() : Dictionary->GetSize(); }
+	const C4Property *First() const;
+	const C4Property *Next(const C4Property *p) const;
+	C4Property *Find(C4String * k);
+	const C4Property *Find(C4String * k) const { return const_cast<C4PropListProperties *>(this)->Find(k); }
+	bool Has(C4String * k) const { return !!Find(k); }
+	void Add(C4Property && p); // key must not be present yet
+	void Remove(C4String * k); // switches to the hash table
+	void Clear();
+	void Swap(C4PropListProperties * other);
+	std::list<const C4Property *> GetSortedListOfElementPointers() const;
+	void CompileFunc(StdCompiler *pComp, C4ValueNumbers *);
+
+private:
+	C4PropListShape *Shape; // NULL in dictionary mode
+	std::vector<C4Property> Slots; // values in the order of Shape
+	C4Set<C4Property> *Dictionary;
+	void MakeDictionary();
+};
+
 class C4PropListNumbered;
 class C4PropList
 {
@@ -146,7 +233,7 @@ private:
 	void AddRef(C4Value *pRef);
 	void DelRef(const C4Value *pRef, C4Value * pNextRef);
 	C4Value *FirstRef; // No-Save
-	C4Set<C4Property> Properties;
+	C4PropListProperties Properties;
 	C4Value prototype;
 	bool constant; // if true, this proplist is not changeable
 	friend class C4Value;
@@ -28,6 +28,7 @@
 C4ScriptHost::C4ScriptHost()
 {
 	Script = NULL;
+	Tokens = NULL;
 	stringTable = 0;
 	SourceScripts.push_back(this);
 	LocalNamed.Reset();
@@ -47,6 +48,7 @@ void C4ScriptHost::Clear()
 	C4AulScript::Clear();
 	ComponentHost.Clear();
 	Script.Clear();
+	ClearTokens();
 	LocalNamed.Reset();
 	LocalValues.Clear();
 	SourceScripts.clear();
@@ -36,6 +36,7 @@ public:
 	virtual bool LoadData(const char *szFilename, const char *szData, class C4LangStringTable *pLocalTable);
 	const char *GetScript() const { return Script.getData(); }
 	virtual C4ScriptHost * GetScriptHost() { return this; }
+	void ClearTokens(); // free tokens left over from linking
 	std::list<C4ScriptHost *> SourceScripts;
 protected:
 	C4ScriptHost();
@@ -53,15 +54,16 @@ protected:
 	std::list<StdCopyStrBuf> Appends; // append list
 
 	virtual void AddEngineFunctions() {}; // add any engine functions specific to this script host
-	void CopyPropList(C4Set<C4Property> & from, C4PropListStatic * to);
+	void CopyPropList(C4PropListProperties & from, C4PropListStatic * to);
 	bool ResolveIncludes(C4DefList *rDefs); // resolve includes
 	bool ResolveAppends(C4DefList *rDefs); // resolve appends
 	bool Resolving; // set while include-resolving, to catch circular includes
 	bool IncludesResolved;
 
 	StdStrBuf Script; // script
+	class C4AulTokenCache *Tokens; // script split into tokens, only kept while linking
 	C4ValueMapNames LocalNamed;
-	C4Set<C4Property> LocalValues;
+	C4PropListProperties LocalValues;
 	friend class C4AulParse;
 	friend class C4AulScriptFunc;
 	friend class C4AulDebug;
@@ -71,6 +71,8 @@ bool C4GameObjects::Remove(C4Object*) {return 0;}
 bool C4GameObjects::AssignInfo() {return 0;}
 bool C4GameObjects::ValidateOwners() {return 0;}
 C4Value C4GameObjects::GRBroadcast(char const*, C4AulParSet*, bool, bool) {return C4Value();}
+void C4GameObjects::InsertLinkBefore(C4ObjectLink*, C4ObjectLink*) {}
+void C4GameObjects::InsertLink(C4ObjectLink*, C4ObjectLink*) {}
 
 C4ObjectList::C4ObjectList() {}
 C4ObjectList::~C4ObjectList() {}
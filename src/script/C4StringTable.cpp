@@ -19,32 +19,42 @@
 #include <C4StringTable.h>
 
 
-// *** C4Set
-template<> template<>
-unsigned int C4Set<C4String *>::Hash<const char *>(const char * const & s)
+// *** C4StringKey
+
+C4StringKey::C4StringKey(const char *s, size_t len)
+: Data(s)
 {
 	// Fowler/Noll/Vo hash
+	// Script strings end at the first null character, even if the buffer goes on
 	unsigned int h = 2166136261u;
-	const char * p = s;
-	while (*p)
-		h = (h ^ *(p++)) * 16777619;
-	return h;
+	const char *p = s, *end = s + len;
+	for (; p != end && *p; ++p)
+		h = (h ^ *p) * 16777619;
+	Hash = h;
+	Length = p - s;
 }
 
-template<> template<>
-bool C4Set<C4String *>::Equals<const char *>(C4String * const & a, const char * const & b)
+C4StringKey::C4StringKey(const char *s)
+: Data(s)
 {
-	return a->GetData() == b;
+	unsigned int h = 2166136261u;
+	const char *p = s;
+	for (; *p; ++p)
+		h = (h ^ *p) * 16777619;
+	Hash = h;
+	Length = p - s;
 }
 
 // *** C4String
 
-C4String::C4String(StdStrBuf strString)
-: RefCnt(0)
+C4String::C4String(const C4StringKey &key)
+: RefCnt(0), Hash(key.Hash)
 {
-	// take string
-	Data.Take(std::move(strString));
-	Hash = Strings.Set.Hash(Data.getData());
+	// copy string behind the object (see operator new)
+	char *pData = reinterpret_cast<char *>(this + 1);
+	std::memcpy(pData, key.Data, key.Length);
+	pData[key.Length] = 0;
+	Data.Ref(pData, key.Length);
 	// reg
 	Strings.Set.Add(this);
 }
@@ -74,7 +84,7 @@ void C4String::operator=(const char * s)
 	assert(!Data);
 	// ref string
 	Data.Ref(s);
-	Hash = Strings.Set.Hash(Data.getData());
+	Hash = C4StringKey(s).Hash;
 	// reg
 	Strings.Set.Add(this);
 }
@@ -295,16 +305,11 @@ C4StringTable::~C4StringTable()
 	assert(Set.GetSize() == P_LAST);
 }
 
-C4String *C4StringTable::RegString(StdStrBuf String)
+C4String *C4StringTable::RegString(const C4StringKey &key)
 {
-	C4String * s = FindString(String.getData());
+	C4String * s = FindString(key);
 	if (s)
 		return s;
 	else
-		return new C4String(String);
-}
-
-C4String *C4StringTable::FindString(const char *strString)
-{
-	return Set.Get(strString);
+		return new (key) C4String(key);
 }
@@ -18,6 +18,16 @@
 #ifndef C4STRINGTABLE_H
 #define C4STRINGTABLE_H
 
+// a string to look up in the string table, hashed only once
+struct C4StringKey
+{
+	const char *Data;
+	size_t Length;
+	unsigned int Hash;
+	C4StringKey(const char *s, size_t len);
+	explicit C4StringKey(const char *s);
+};
+
 class C4String
 {
 	int RefCnt;
@@ -26,7 +36,10 @@ public:
 private:
 	StdCopyStrBuf Data; // string data
 
-	explicit C4String(StdStrBuf strString);
+	// registered strings keep their characters in the same allocation, right behind the object
+	explicit C4String(const C4StringKey &key);
+	static void *operator new(size_t size, const C4StringKey &key) { return ::operator new(size + key.Length + 1); }
+	static void operator delete(void *p, const C4StringKey &) { ::operator delete(p); }
 	C4String();
 	void operator=(const char * s);
 
@@ -34,6 +47,8 @@ private:
 public:
 	~C4String();
 
+	static void operator delete(void *p) { ::operator delete(p); }
+
 	// Add/Remove Reference
 	void IncRef() { ++RefCnt; }
 	void DecRef() { if (!--RefCnt) delete this; }
@@ -160,7 +175,6 @@ public:
 			Table[i] = b.Table[i];
 		return *this;
 	}
-	void CompileFunc(StdCompiler *pComp, C4ValueNumbers *);
 	void Clear()
 	{
 		for (unsigned int i = 0; i < Capacity; ++i)
@@ -269,6 +283,17 @@ inline unsigned int C4Set<C4String *>::Hash<C4String *>(C4String * const & e)
 {
 	return e->Hash;
 }
+template<> template<>
+inline unsigned int C4Set<C4String *>::Hash<C4StringKey>(const C4StringKey & e)
+{
+	return e.Hash;
+}
+template<> template<>
+inline bool C4Set<C4String *>::Equals<C4StringKey>(C4String * const & a, const C4StringKey & b)
+{
+	// compare the hashes first so that probing past other strings is cheap
+	return a->Hash == b.Hash && a->GetData().getLength() == b.Length && !std::memcmp(a->GetCStr(), b.Data, b.Length);
+}
 
 enum C4PropertyName
 {
@@ -466,10 +491,13 @@ public:
 	C4StringTable();
 	virtual ~C4StringTable();
 
-	C4String *RegString(StdStrBuf String);
-	C4String *RegString(const char * s) { return RegString(StdStrBuf(s)); }
+	C4String *RegString(const C4StringKey &key);
+	C4String *RegString(const StdStrBuf &String) { return RegString(C4StringKey(String.getData(), String.getLength())); }
+	C4String *RegString(const char * s) { return RegString(C4StringKey(s)); }
+	C4String *RegString(const char * s, size_t len) { return RegString(C4StringKey(s, len)); }
 	// Find existing C4String
-	C4String *FindString(const char *strString);
+	C4String *FindString(const C4StringKey &key) const { return Set.Get(key); }
+	C4String *FindString(const char *strString) const { return FindString(C4StringKey(strString)); }
 
 private:
 	C4Set<C4String *> Set;
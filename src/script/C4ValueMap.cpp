@@ -211,19 +211,25 @@ void C4ValueMapData::OnNameListChanged(const char **pOldNames, int32_t iOldSize)
 		{
 			pData[i] = pOldData[i];
 		}
-		else for (j = 0; j < pNames->iSize; j++)
+		else if ((j = pNames->GetItemNr(pOldNames[i])) != -1)
 		{
-			if (SEqual(pNames->pNames[j], pOldNames[i]))
-			{
-				pData[j] = pOldData[i];
-				break;
-			}
+			pData[j] = pOldData[i];
 		}
 	}
 	// delete old data array
 	delete[] pOldData;
 }
 
+void C4ValueMapData::OnNameAdded()
+{
+	// grow by one, keeping all values at their index
+	C4Value *pOldData = pData;
+	pData = new C4Value [pNames->iSize] ();
+	for (int32_t i = 0; i < pNames->iSize - 1; i++)
+		pData[i] = pOldData[i];
+	delete[] pOldData;
+}
+
 C4Value *C4ValueMapData::GetItem(int32_t iNr)
 {
 	assert(pNames);
@@ -358,6 +364,7 @@ void C4ValueMapNames::Reset()
 	delete[] pNames;
 	pNames = NULL;
 	iSize = 0;
+	NameIndex.clear();
 }
 
 void C4ValueMapNames::Register(C4ValueMapData *pData)
@@ -414,6 +421,11 @@ void C4ValueMapNames::ChangeNameList(const char **pnNames, int32_t nSize)
 	// set new size
 	iSize = nSize;
 
+	// rebuild index (for duplicate names, the first one wins)
+	NameIndex.clear();
+	for (i = 0; i < nSize; i++)
+		NameIndex.emplace(pNames[i], i);
+
 	// call OnNameListChanged list for all "child" lists
 	C4ValueMapData *pAktData = pFirst;
 	while (pAktData)
@@ -443,24 +455,19 @@ int32_t C4ValueMapNames::AddName(const char *pnName)
 	if ((iNr=GetItemNr(pnName)) != -1)
 		return iNr;
 
-	// create new dummy lists
-	const char **pDummyNames = new const char *[iSize + 1];
-
-	// copy all data from old list
-	// (danger! if ChangeNameList would now delete them before
-	// creating the new list, this would cause cruel errors...)
-	int32_t i;
-	for (i = 0; i < iSize; i++)
-	{
-		pDummyNames[i] = pNames[i];
-	}
-	pDummyNames[i] = pnName;
-
-	// change list
-	ChangeNameList(pDummyNames, iSize + 1);
+	// append the name without copying the others, so their indices stay valid
+	char **pNewNames = new char *[iSize + 1];
+	std::copy(pNames, pNames + iSize, pNewNames);
+	pNewNames[iSize] = new char [SLen(pnName) + 1];
+	SCopy(pnName, pNewNames[iSize], SLen(pnName) + 1);
+	delete[] pNames;
+	pNames = pNewNames;
+	NameIndex.emplace(pNames[iSize], iSize);
+	++iSize;
 
-	// delete dummy arrays
-	delete[] pDummyNames;
+	// data lists just have to grow
+	for (C4ValueMapData *pAktData = pFirst; pAktData; pAktData = pAktData->pNext)
+		pAktData->OnNameAdded();
 
 	// return index to new element (simply last element)
 	return iSize-1;
@@ -468,8 +475,6 @@ int32_t C4ValueMapNames::AddName(const char *pnName)
 
 int32_t C4ValueMapNames::GetItemNr(const char *strName)
 {
-	for (int32_t i = 0; i < iSize; i++)
-		if (SEqual(pNames[i], strName))
-			return i;
-	return -1;
+	auto it = NameIndex.find(strName);
+	return it != NameIndex.end() ? it->second : -1;
 }
@@ -17,6 +17,8 @@
 #ifndef INC_C4ValueMap2
 #define INC_C4ValueMap2
 
+#include <unordered_map>
+
 // implements a list of C4Values associated with a name list.
 // the list is split in the two components (data/names) to make it possible
 // to have multiple data lists using a single name list
@@ -83,6 +85,9 @@ private:
 	// was changed and from SetNameList (the data list has to be rordered...)
 	void OnNameListChanged(const char **pOldNames, int32_t iOldSize);
 
+	// called by names list when a name was appended (all other indices stay the same)
+	void OnNameAdded();
+
 	// (Re)Allocs data list
 	// old data will be deleted!
 	// (size taken from pNames->iSize)
@@ -130,6 +135,20 @@ private:
 	// points to first data list using this name list
 	C4ValueMapData *pFirst;
 
+	// index of each name, so lookups by name don't have to compare all names
+	// (keys point to the strings in pNames)
+	struct NameHash
+	{
+		size_t operator()(const char *s) const
+		{
+			size_t h = 2166136261u;
+			while (*s) h = (h ^ (unsigned char) *s++) * 16777619u;
+			return h;
+		}
+	};
+	struct NameEqual { bool operator()(const char *a, const char *b) const { return SEqual(a, b); } };
+	std::unordered_map<const char *, int32_t, NameHash, NameEqual> NameIndex;
+
 	void Register(C4ValueMapData *pData);
 	void UnRegister(C4ValueMapData *pData);
 
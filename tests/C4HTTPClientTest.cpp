@@ -0,0 +1,166 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2015, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "network/C4HTTPClient.h"
+
+#include <gtest/gtest.h>
+
+const uint16_t StubPort = 11119;
+
+// stand-in for the masterserver: answers every request with a fixed body
+class HTTPStubServer : public C4NetIOTCP, private C4NetIO::CBClass
+{
+public:
+	HTTPStubServer() : iConnections(0), iRequests(0), iDropRequests(0), fKeepAlive(true)
+	{
+		SetCallback(this);
+	}
+
+	int iConnections, iRequests;
+	int iDropRequests; // close the connection instead of answering
+	bool fKeepAlive;
+
+protected:
+	virtual void PackPacket(const C4NetIOPacket &rPacket, StdBuf &rOutBuf)
+	{
+		rOutBuf.Append(rPacket);
+	}
+
+	virtual size_t UnpackPacket(const StdBuf &rInBuf, const C4NetIO::addr_t &addr)
+	{
+		StdStrBuf Data; Data.Copy(getBufPtr<char>(rInBuf), rInBuf.getSize());
+		const char *pEnd = SSearch(Data.getData(), "\r\n\r\n");
+		if (!pEnd)
+			return 0;
+		++iRequests;
+		if (iDropRequests)
+		{
+			--iDropRequests;
+			Close(addr);
+			return rInBuf.getSize();
+		}
+		StdStrBuf Response = FormatString(
+		                       "HTTP/1.1 200 OK\r\n"
+		                       "%s"
+		                       "Content-Length: 5\r\n"
+		                       "\r\n"
+		                       "hello",
+		                       fKeepAlive ? "connection: keep-alive\r\n" : "");
+		Send(C4NetIOPacket(Response.getData(), Response.getLength(), false, addr));
+		if (!fKeepAlive)
+			Close(addr);
+		return pEnd - Data.getData();
+	}
+
+	virtual bool OnConn(const C4NetIO::addr_t &AddrPeer, const C4NetIO::addr_t &AddrConnect, const addr_t *pOwnAddr, C4NetIO *pNetIO)
+	{
+		++iConnections;
+		return true;
+	}
+	virtual void OnDisconn(const C4NetIO::addr_t &AddrPeer, C4NetIO *pNetIO, const char *szReason) { }
+	virtual void OnPacket(const class C4NetIOPacket &rPacket, C4NetIO *pNetIO) { }
+};
+
+class C4HTTPClientTest : public ::testing::Test
+{
+protected:
+	virtual void SetUp()
+	{
+		ASSERT_TRUE(Server.Init(StubPort));
+		ASSERT_TRUE(Client.Init());
+	}
+
+	// both ends run on this thread
+	void Run()
+	{
+		for (int i = 0; i < 500 && Client.isBusy(); ++i)
+		{
+			Server.Execute(0);
+			Client.Execute(10);
+		}
+		// let the server see what the client did last
+		Server.Execute(10);
+	}
+
+	HTTPStubServer Server;
+	C4HTTPClient Client;
+};
+
+TEST_F(C4HTTPClientTest, ReadsContentLength)
+{
+	Server.fKeepAlive = false;
+	ASSERT_TRUE(Client.SetServer(FormatString("127.0.0.1:%d/test", int(StubPort)).getData()));
+	ASSERT_TRUE(Client.Query(NULL, false));
+	Run();
+	EXPECT_FALSE(Client.isBusy());
+	ASSERT_TRUE(Client.isSuccess()) << Client.GetError();
+	EXPECT_STREQ("hello", Client.getResultString());
+	EXPECT_EQ(5u, Client.getTotalSize());
+	EXPECT_FALSE(Client.isConnected());
+}
+
+TEST_F(C4HTTPClientTest, ReusesKeptAliveConnection)
+{
+	ASSERT_TRUE(Client.SetServer(FormatString("127.0.0.1:%d/test", int(StubPort)).getData()));
+	for (int i = 0; i < 3; ++i)
+	{
+		ASSERT_TRUE(Client.Query(NULL, false));
+		Run();
+		ASSERT_TRUE(Client.isSuccess()) << Client.GetError();
+		EXPECT_STREQ("hello", Client.getResultString());
+		EXPECT_TRUE(Client.isConnected());
+	}
+	EXPECT_EQ(1, Server.iConnections);
+	EXPECT_EQ(3, Server.iRequests);
+}
+
+TEST_F(C4HTTPClientTest, RetriesOnceWhenIdleConnectionIsClosed)
+{
+	ASSERT_TRUE(Client.SetServer(FormatString("127.0.0.1:%d/test", int(StubPort)).getData()));
+	ASSERT_TRUE(Client.Query(NULL, false));
+	Run();
+	ASSERT_TRUE(Client.isSuccess()) << Client.GetError();
+	// the server drops the connection instead of answering: the request is sent again on a new one
+	Server.iDropRequests = 1;
+	ASSERT_TRUE(Client.Query(NULL, false));
+	Run();
+	ASSERT_TRUE(Client.isSuccess()) << Client.GetError();
+	EXPECT_STREQ("hello", Client.getResultString());
+	EXPECT_EQ(2, Server.iConnections);
+	EXPECT_EQ(3, Server.iRequests);
+	// but only once
+	Server.iDropRequests = 2;
+	ASSERT_TRUE(Client.Query(NULL, false));
+	Run();
+	EXPECT_FALSE(Client.isBusy());
+	EXPECT_FALSE(Client.isSuccess());
+	EXPECT_EQ(3, Server.iConnections);
+	EXPECT_EQ(5, Server.iRequests);
+}
+
+TEST_F(C4HTTPClientTest, ResolvesInBackground)
+{
+	ASSERT_TRUE(Client.SetServer(FormatString("localhost:%d/test", int(StubPort)).getData()));
+	// the request waits for the address
+	ASSERT_TRUE(Client.Query(NULL, false));
+	// the resolving thread wakes the client up, it does not have to poll
+	C4TimeMilliseconds tStart = C4TimeMilliseconds::Now();
+	Client.Execute(5000);
+	EXPECT_LT(C4TimeMilliseconds::Now() - tStart, 5000);
+	Run();
+	ASSERT_TRUE(Client.isSuccess()) << Client.GetError();
+	EXPECT_STREQ("hello", Client.getResultString());
+}
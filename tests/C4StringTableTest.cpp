@@ -51,3 +51,19 @@ TEST(C4StringTableTest, ComparisonOperators)
 	EXPECT_NE(v1, v2);
 	EXPECT_EQ(v1, v3);
 }
+
+TEST(C4StringTableTest, LengthLimitedLookup)
+{
+	const char buf[] = "ApfelmusKuchen";
+	C4String * str = Strings.RegString(buf, 8);
+	ASSERT_TRUE(str);
+	EXPECT_STREQ("Apfelmus", str->GetCStr());
+	EXPECT_EQ(str, Strings.RegString("Apfelmus"));
+	EXPECT_EQ(str, Strings.FindString(C4StringKey(buf, 8)));
+	EXPECT_FALSE(Strings.FindString(C4StringKey(buf, 5)));
+	// strings end at the first null character
+	EXPECT_EQ(str, Strings.RegString(StdStrBuf("Apfelmus\0Kuchen", size_t(15))));
+	str->IncRef();
+	str->DecRef();
+	EXPECT_FALSE(Strings.FindString("Apfelmus"));
+}
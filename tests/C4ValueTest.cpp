@@ -15,6 +15,7 @@
 
 #include <C4Include.h>
 #include "script/C4Value.h"
+#include "script/C4ValueMap.h"
 
 #include <gtest/gtest.h>
 
@@ -34,3 +35,34 @@ TEST(C4ValueTest, SanityTests)
 	EXPECT_TRUE(C4Value(true));
 	EXPECT_FALSE(C4Value(false));
 }
+
+TEST(C4ValueMapTest, NamesKeepValues)
+{
+	C4ValueMapNames Names;
+	C4ValueMapData Data1, Data2;
+	Data1.SetNameList(&Names);
+	Data2.SetNameList(&Names);
+	EXPECT_EQ(-1, Names.GetItemNr("a"));
+	EXPECT_EQ(0, Names.AddName("a"));
+	EXPECT_EQ(1, Names.AddName("b"));
+	EXPECT_EQ(0, Names.AddName("a"));
+	Data1["a"] = C4VInt(1); Data1["b"] = C4VInt(2);
+	Data2["b"] = C4VInt(3);
+	// appending keeps values at their index
+	EXPECT_EQ(2, Names.AddName("c"));
+	EXPECT_EQ(2, Names.GetItemNr("c"));
+	EXPECT_EQ(C4VInt(1), Data1["a"]);
+	EXPECT_EQ(C4VInt(2), Data1["b"]);
+	EXPECT_EQ(C4VInt(3), Data2["b"]);
+	EXPECT_EQ(C4Value(), Data1["c"]);
+	// reordering moves values along with their names
+	const char *NewNames[] = { "c", "b", "d" };
+	Names.SetNameArray(NewNames, 3);
+	EXPECT_EQ(-1, Names.GetItemNr("a"));
+	EXPECT_EQ(1, Names.GetItemNr("b"));
+	EXPECT_EQ(C4VInt(2), Data1["b"]);
+	EXPECT_EQ(C4VInt(3), Data2["b"]);
+	EXPECT_EQ(C4Value(), Data1["d"]);
+	Names.Reset();
+	EXPECT_EQ(-1, Names.GetItemNr("b"));
+}
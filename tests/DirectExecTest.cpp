@@ -27,8 +27,7 @@ TEST(DirectExecTest, SanityTests)
 	delete pScript;
 }
 
-template<typename T>
-bool operator==(const C4Set<T>& lhs, const C4Set<T>& rhs)
+bool operator==(const C4PropListProperties& lhs, const C4PropListProperties& rhs)
 {
 	if (lhs.GetSize() != rhs.GetSize()) return false;
 	auto lit = lhs.First();
@@ -36,7 +35,7 @@ bool operator==(const C4Set<T>& lhs, const C4Set<T>& rhs)
 	while(lit != nullptr) {
 		if (*lit != *rit) return false;
 		lit = lhs.Next(lit);
-		rit = lhs.Next(rit);
+		rit = rhs.Next(rit);
 	}
 	return true;
 }
@@ -143,11 +143,61 @@ TEST_F(C4AulTest, ValueReturn)
 		RunExpr("{\"a\": 1, \"b\"=[]}"));
 }
 
+TEST_F(C4AulTest, PropListProperties)
+{
+	// Proplists with the same keys share their layout. Changing one must not affect the other.
+	EXPECT_EQ(
+		C4VArray(C4VInt(1), C4VNull, C4VInt(3), C4VInt(5), C4VInt(2)),
+		RunCode("var a = {x=1, y=2, z=3}, b = {x=4, y=5, z=6}; ResetProperty(\"y\", a); return [a.x, a.y, a.z, b.y, GetLength(GetProperties(a))];"));
+	// Proplists with many keys
+	EXPECT_EQ(
+		C4VArray(C4VInt(99), C4VNull, C4VInt(99)),
+		RunCode("var p = {}; for (var i = 0; i < 100; ++i) SetProperty(Format(\"p%d\", i), i, p); ResetProperty(\"p50\", p); return [p.p99, p.p50, GetLength(GetProperties(p))];"));
+}
+
 TEST_F(C4AulTest, Translate)
 {
 	EXPECT_EQ(C4VString("a"), RunExpr("Translate(\"a\")"));
 }
 
+TEST_F(C4AulTest, CodeCache)
+{
+	// the standalone config is not defaulted
+	Config.Developer.ScriptCache = 1;
+	ScriptEngine.CodeCache.Clear();
+	// the code of an unchanged function is generated once
+	EXPECT_EQ(C4VInt(3), RunExpr("1 + 2"));
+	EXPECT_EQ(0, ScriptEngine.CodeCache.Hits);
+	EXPECT_EQ(C4VInt(3), RunExpr("1 + 2"));
+	EXPECT_EQ(1, ScriptEngine.CodeCache.Hits);
+	// but generated again when a name it uses changes its meaning
+	EXPECT_EQ(C4VInt(1), RunCode("static const C = 1; func Main() { return C; }", false));
+	EXPECT_EQ(C4VInt(2), RunCode("static const C = 2; func Main() { return C; }", false));
+	EXPECT_EQ(C4VInt(1), RunCode("func Main() { return F(1, 2); } func F(a) { return a; }", false));
+	EXPECT_EQ(C4VInt(2), RunCode("func Main() { return F(1, 2); } func F(a, b) { return b; }", false));
+	EXPECT_EQ(C4VInt(3), RunCode("static g; func Main() { Set(); return g; } func Set() { g = 3; }", false));
+	EXPECT_EQ(C4VInt(4), RunCode("static h, g; func Main() { Set(); return g; } func Set() { h = 5; g = 4; }", false));
+
+	// the cache survives saving and loading
+	const char *szFilename = "CodeCacheTest.bin";
+	ScriptEngine.CodeCache.Clear();
+	EXPECT_FALSE(ScriptEngine.CodeCache.Load(szFilename));
+	EXPECT_EQ(C4VString("Hello"), RunExpr("\"Hello\""));
+	EXPECT_TRUE(ScriptEngine.CodeCache.Save());
+	ScriptEngine.CodeCache.Clear();
+	EXPECT_TRUE(ScriptEngine.CodeCache.Load(szFilename));
+	EXPECT_EQ(C4VString("Hello"), RunExpr("\"Hello\""));
+	EXPECT_EQ(1, ScriptEngine.CodeCache.Hits);
+	ScriptEngine.CodeCache.Clear();
+	EraseFile(szFilename);
+	// nothing is cached when switched off
+	Config.Developer.ScriptCache = 0;
+	EXPECT_EQ(C4VInt(3), RunExpr("1 + 2"));
+	EXPECT_EQ(C4VInt(3), RunExpr("1 + 2"));
+	EXPECT_EQ(0, ScriptEngine.CodeCache.Hits);
+	EXPECT_EQ(0, ScriptEngine.CodeCache.Misses);
+}
+
 class AulMathTest : public C4AulTest
 {
 protected: